@@ -0,0 +1,60 @@
+# ================================================================================
+# BENCH - ALVO "bench" DO PLATFORMIO (pio run -e moduloN -t bench)
+# ================================================================================
+# Compila bench/simavr_bench.c (precisa de libsimavr + libelf no host), pega
+# os endereços de loop/timer_millis/exercicio_atual com avr-nm e roda o ELF
+# do ambiente no simavr. Opções no platformio.ini:
+#   custom_bench_modulo   = 1 | 2 | 3 (0 = firmware de medição: só a USART0)
+#   custom_bench_segundos = tempo simulado por execução (padrão 10; a
+#                           variável BENCH_SEGUNDOS tem prioridade)
+# ================================================================================
+
+Import("env")
+
+import os
+import subprocess
+
+SIMBOLOS = ("loop", "timer_millis", "exercicio_atual")
+
+
+# Nos ambientes bare o loop() tem ligação C++ ("loop()" com -C) e, com LTO,
+# símbolos locais podem ganhar sufixo (".lto_priv.0")
+def enderecos(elf):
+    nm = env.subst("$CC").replace("gcc", "nm")
+    saida = subprocess.check_output([nm, "-C", elf], env=env["ENV"]).decode()
+    achados = {}
+    for linha in saida.splitlines():
+        partes = linha.split()
+        if len(partes) != 3:
+            continue
+        nome = partes[2].split("(")[0].split(".")[0]
+        if nome in SIMBOLOS and nome not in achados:
+            achados[nome] = int(partes[0], 16)
+    return achados
+
+
+def compila_harness():
+    fonte = os.path.join(env.subst("$PROJECT_DIR"), "bench", "simavr_bench.c")
+    exe = os.path.join(env.subst("$BUILD_DIR"), "simavr_bench")
+    if not os.path.exists(exe) or os.path.getmtime(exe) < os.path.getmtime(fonte):
+        subprocess.check_call(["cc", "-O2", "-std=gnu99", "-I/usr/include/simavr",
+                               fonte, "-o", exe, "-lsimavr", "-lelf"])
+    return exe
+
+
+def roda_bench(target, source, env):
+    elf = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+    modulo = env.GetProjectOption("custom_bench_modulo", "1")
+    segundos = os.environ.get("BENCH_SEGUNDOS") or env.GetProjectOption("custom_bench_segundos", "10")
+    args = [compila_harness(), elf, str(modulo), str(segundos)]
+    args += ["%s=0x%x" % (nome, end) for nome, end in sorted(enderecos(elf).items())]
+    return subprocess.call(args)
+
+
+env.AddCustomTarget(
+    name="bench",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=roda_bench,
+    title="Bench",
+    description="Mede o módulo no simavr (ciclos, latência de ISR, uso de CPU)",
+)
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# ================================================================================
+# COMPARA - CORE ARDUINO x BARE-METAL
+#   python3 bench/compara.py [segundos] [--contra REV] [modulo...]
+# ================================================================================
+# Para cada módulo compila os ambientes Arduino e bare (LTO, LTO +
+# -mcall-prologues), roda o alvo "bench" no simavr e imprime uma tabela:
+#   flash/RAM   - avr-size (.text+.data / .data+.bss)
+#   boot        - ciclos do reset até o 1º loop() (Módulo 2: 1º SLEEP)
+#   cpu%/isr%   - ciclos acordado e dentro de ISR sobre o total simulado
+# --contra REV: compila os mesmos ambientes também na revisão REV (git
+# worktree temporário) e imprime as duas linhas, REV e a árvore atual
+# (ex.: --contra HEAD~1 modulo3 para medir uma mudança só no Módulo 3).
+# Precisa de pio, libsimavr e libelf no host (ver bench/bench.py).
+# ================================================================================
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+GRUPOS = (
+    ("main",    ("uno", "bare_main")),
+    ("modulo1", ("modulo1", "bare_modulo1", "bare_modulo1_cp")),
+    ("modulo2", ("modulo2", "bare_modulo2", "bare_modulo2_cp")),
+    ("modulo3", ("modulo3", "bare_modulo3", "bare_modulo3_cp")),
+)
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def avr_size():
+    achado = shutil.which("avr-size")
+    if achado:
+        return achado
+    return os.path.expanduser("~/.platformio/packages/toolchain-atmelavr/bin/avr-size")
+
+
+def tamanhos(raiz, ambiente):
+    elf = os.path.join(raiz, ".pio", "build", ambiente, "firmware.elf")
+    saida = subprocess.check_output([avr_size(), "-A", elf]).decode()
+    secoes = {}
+    for linha in saida.splitlines():
+        partes = linha.split()
+        if len(partes) == 3 and partes[0].startswith("."):
+            secoes[partes[0]] = int(partes[1])
+    flash = secoes.get(".text", 0) + secoes.get(".data", 0)
+    ram = secoes.get(".data", 0) + secoes.get(".bss", 0) + secoes.get(".noinit", 0)
+    return flash, ram
+
+
+def bench(raiz, ambiente, segundos):
+    args = ["pio", "run", "-d", raiz, "-e", ambiente, "-t", "bench"]
+    amb = dict(os.environ)
+    if segundos:
+        amb["BENCH_SEGUNDOS"] = segundos
+    saida = subprocess.run(args, env=amb, stdout=subprocess.PIPE, stderr=subprocess.STDOUT).stdout.decode()
+    m = re.search(r"RESUMO boot_ciclos=(\d+) cpu=([\d.]+) isr=([\d.]+)", saida)
+    if not m:
+        sys.stderr.write(saida)
+        raise SystemExit("compara: bench de %s falhou" % ambiente)
+    return int(m.group(1)), float(m.group(2)), float(m.group(3))
+
+
+def main():
+    segundos = None
+    contra = None
+    modulos = []
+    args = sys.argv[1:]
+    while args:
+        a = args.pop(0)
+        if a == "--contra":
+            contra = args.pop(0)
+        elif a.isdigit():
+            segundos = a
+        else:
+            modulos.append(a)
+
+    arvores = [("atual", RAIZ)]
+    worktree = None
+    if contra:
+        worktree = tempfile.mkdtemp(prefix="compara-")
+        subprocess.check_call(["git", "-C", RAIZ, "worktree", "add", "--detach", worktree, contra])
+        arvores.insert(0, (contra, worktree))
+
+    try:
+        print("%-8s %-16s %-8s %7s %6s %10s %8s %7s %7s" %
+              ("modulo", "ambiente", "arvore", "flash", "ram", "boot_cic", "boot_us", "cpu%", "isr%"))
+        for modulo, ambientes in GRUPOS:
+            if modulos and modulo not in modulos:
+                continue
+            for ambiente in ambientes:
+                for nome, raiz in arvores:
+                    boot, cpu, isr = bench(raiz, ambiente, segundos)
+                    flash, ram = tamanhos(raiz, ambiente)
+                    print("%-8s %-16s %-8s %7d %6d %10d %8.1f %7.3f %7.3f" %
+                          (modulo, ambiente, nome[:8], flash, ram, boot, boot / 16.0, cpu, isr))
+    finally:
+        if worktree:
+            subprocess.call(["git", "-C", RAIZ, "worktree", "remove", "--force", worktree])
+
+
+if __name__ == "__main__":
+    main()
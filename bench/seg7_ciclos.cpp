@@ -0,0 +1,147 @@
+/*
+ * ================================================================================
+ * BENCH - CICLOS DA CONVERSÃO BINÁRIO → DÍGITOS (lib/seg7 x /10 e %10)
+ * ================================================================================
+ * Firmware só de medição (pio run -e bench_seg7 -t bench): roda no simavr,
+ * mede cada método com o Timer1 a 1 ciclo/contagem sobre 13108 valores
+ * (0 a 65535, de 5 em 5) e manda a tabela pela USART0, que o
+ * simavr_bench (módulo 0) repassa para o terminal:
+ * - divisao:    v % 10, v /= 10 por dígito (__udivmodhi4 com -Os)
+ * - dabble:     double dabble (desloca e soma 3), BCD compactado em bytes
+ * - seg7_bcd16: pesos k·10^n da lib/seg7
+ * - seg7_u16:   conversão + montagem de 5 glifos (zeros apagados)
+ * - seg7_hex:   seg7_u16 em hexa
+ * Os ciclos da chamada indireta (medidos com uma função vazia) são
+ * descontados. Tudo com interrupções desligadas; a serial só depois.
+ * ================================================================================
+ */
+
+#include "boot.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdio.h>
+#include "serial.h"
+#include "seg7.h"
+
+#define PASSO_VALORES   5
+
+typedef void (*conversao_t)(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]);
+
+__attribute__((noinline)) static void vazio(uint16_t, uint8_t *) {}
+
+__attribute__((noinline)) static void divisao(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]) {
+    for (uint8_t i = 0; i < SEG7_DIGITOS_MAX; i++) {
+        d[i] = v % 10;
+        v /= 10;
+    }
+}
+
+// Nibble >= 5 antes do deslocamento: soma 3 (vira >= 8 e "vai um" certo)
+#define AJUSTA(b)   do {                                \
+    if (((b) & 0x0F) >= 0x05) (b) += 0x03;              \
+    if (((b) & 0xF0) >= 0x50) (b) += 0x30;              \
+} while (0)
+
+__attribute__((noinline)) static void dabble(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]) {
+    uint8_t b0 = 0, b1 = 0, b2 = 0;     // BCD compactado: b0 = dezenas|unidades
+    for (uint8_t i = 0; i < 16; i++) {
+        AJUSTA(b0);
+        AJUSTA(b1);
+        AJUSTA(b2);
+        b2 = (uint8_t)((b2 << 1) | (b1 >> 7));
+        b1 = (uint8_t)((b1 << 1) | (b0 >> 7));
+        b0 = (uint8_t)((b0 << 1) | (v >> 15));
+        v <<= 1;
+    }
+    d[0] = b0 & 0x0F;
+    d[1] = b0 >> 4;
+    d[2] = b1 & 0x0F;
+    d[3] = b1 >> 4;
+    d[4] = b2;
+}
+
+__attribute__((noinline)) static void lib_bcd(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]) {
+    seg7_bcd16(v, d);
+}
+
+__attribute__((noinline)) static void lib_u16(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]) {
+    seg7_u16(d, SEG7_DIGITOS_MAX, v, SEG7_DEC);
+}
+
+__attribute__((noinline)) static void lib_hex(uint16_t v, uint8_t d[SEG7_DIGITOS_MAX]) {
+    seg7_u16(d, SEG7_DIGITOS_MAX, v, SEG7_HEX);
+}
+
+static const struct { conversao_t f; const char *nome; } METODOS[] = {
+    { divisao, "divisao" },
+    { dabble,  "dabble" },
+    { lib_bcd, "seg7_bcd16" },
+    { lib_u16, "seg7_u16" },
+    { lib_hex, "seg7_hex" },
+};
+#define NUM_METODOS (sizeof(METODOS) / sizeof(METODOS[0]))
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint32_t soma;
+} medida_t;
+
+static medida_t medidas[NUM_METODOS];
+static uint8_t errados[NUM_METODOS];
+
+__attribute__((noinline, noclone)) static uint16_t mede(conversao_t f, uint16_t v, uint8_t *d) {
+    uint16_t t0 = TCNT1;
+    f(v, d);
+    return (uint16_t)(TCNT1 - t0);
+}
+
+void setup() {
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);               // Modo normal, 1 contagem = 1 ciclo
+    uint8_t d[SEG7_DIGITOS_MAX], ref[SEG7_DIGITOS_MAX];
+    uint16_t base = mede(vazio, 0, d);
+
+    for (uint8_t m = 0; m < NUM_METODOS; m++) {
+        medida_t *r = &medidas[m];
+        r->min = 0xFFFF;
+        for (uint32_t v = 0; v <= 0xFFFF; v += PASSO_VALORES) {
+            uint16_t c = mede(METODOS[m].f, (uint16_t)v, d) - base;
+            if (c < r->min) r->min = c;
+            if (c > r->max) r->max = c;
+            r->soma += c;
+
+            // dabble e seg7_bcd16 têm de dar os mesmos dígitos da divisão
+            if (m >= 1 && m <= 2) {
+                divisao((uint16_t)v, ref);
+                for (uint8_t i = 0; i < SEG7_DIGITOS_MAX; i++) {
+                    if (d[i] != ref[i] && errados[m] < 255) errados[m]++;
+                }
+            }
+        }
+    }
+
+    serial_init();
+    sei();
+    char linha[48];
+    uint16_t n_valores = 0xFFFF / PASSO_VALORES + 1;
+    serial_envia_espera(linha, (uint8_t)snprintf(linha, sizeof(linha), "== %u valores, ciclos por conversao ==\n", n_valores));
+    serial_envia_espera(linha, (uint8_t)snprintf(linha, sizeof(linha), "%-11s %5s %5s %5s %4s\n", "metodo", "min", "media", "max", "erro"));
+    for (uint8_t m = 0; m < NUM_METODOS; m++) {
+        medida_t *r = &medidas[m];
+        serial_envia_espera(linha, (uint8_t)snprintf(linha, sizeof(linha), "%-11s %5u %5lu %5u %4u\n", METODOS[m].nome,
+                                                     r->min, (unsigned long)(r->soma / n_valores), r->max, errados[m]));
+    }
+
+    // Fila vazia e último byte fora do registrador de deslocamento
+    while (serial_livre() < SERIAL_TX_N - 1);
+    while (!(UCSR0A & (1 << TXC0)));
+}
+
+// SLEEP com interrupções desligadas: o simavr encerra a simulação
+void loop() {
+    cli();
+    sleep_enable();
+    sleep_cpu();
+}
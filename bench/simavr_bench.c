@@ -0,0 +1,378 @@
+/*
+ * ================================================================================
+ * BENCH - MEDIÇÃO CICLO A CICLO NO SIMAVR
+ * ================================================================================
+ * Roda o ELF real do módulo no simavr (ATmega328P @ 16MHz) e mede, por
+ * exercício:
+ * - loop()/s e SLEEP/s (acordadas)
+ * - latência de entrada das ISRs (ciclos entre flag pendente e 1ª instrução)
+ * - maior intervalo entre leituras de timer_millis fora de ISR
+ *   (LDS do 1º byte = uma chamada de millis_custom())
+ * - uso de CPU (ciclos acordado / ciclos totais) e carga de interrupção
+ *   (ciclos dentro de ISR / ciclos totais)
+ * - sono em POWER_DOWN (% do tempo, modo lido do SMCR no SLEEP) e latência
+ *   estimada para acordar: borda do botão com a CPU em POWER_DOWN até a
+ *   ISR PCINT1, mais a partida do oscilador (PARTIDA_CK, fusíveis do Uno),
+ *   que o simavr não simula
+ * - boot: ciclos do reset até a 1ª entrada em loop() (sem o símbolo loop,
+ *   até o 1º SLEEP)
+ * - trocas de pino em PORTB/C/D (BENCH_TRACE=arquivo grava cada escrita)
+ * Botões (Módulo 3): roteiro fixo de cliques/duplo/longo em PC2-PC4.
+ * Módulo 0 (firmwares de medição, ex.: bench/seg7_ciclos.cpp): sem
+ * relatório, só repassa para o terminal o que o firmware manda pela USART0
+ * e para no SLEEP com interrupções desligadas.
+ *
+ * Uso (normalmente via "pio run -e moduloN -t bench"):
+ *   simavr_bench <elf> <modulo 0|1|2|3> <segundos> [loop=0x..] [timer_millis=0x..]
+ *                [exercicio_atual=0x..]
+ * ================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "sim_interrupts.h"
+#include "sim_cycle_timers.h"
+#include "avr_ioport.h"
+#include "avr_uart.h"
+
+#define F_CPU               16000000UL
+#define CICLOS_MS           (F_CPU / 1000UL)
+#define MAX_EX              16
+#define NUM_VETORES         26
+
+#define OP_SLEEP            0x9588
+#define SMCR_END            0x53        // 0x33 no espaço de I/O
+#define SONO_PWR_DOWN       2           // SM2:0
+#define PARTIDA_CK          16384       // CKSEL cristal, SUT = 11: 16K CK
+#define VETOR_PCINT1        4
+#define OP_LDS_MASK         0xFE0F
+#define OP_LDS              0x9000
+
+// Vetores medidos (números da tabela do ATmega328P)
+static const struct { uint8_t v; const char *nome; } VETORES[] = {
+    { 4,  "PCINT1" },
+    { 7,  "T2_COMPA" },
+    { 8,  "T2_COMPB" },
+    { 11, "T1_COMPA" },
+    { 16, "T0_OVF" },
+};
+#define NUM_MEDIDOS (sizeof(VETORES) / sizeof(VETORES[0]))
+
+typedef struct {
+    uint64_t ciclos;
+    uint64_t dormindo;
+    uint64_t em_isr;
+    uint32_t loops;
+    uint32_t sleeps;
+    uint64_t leitura_ant;
+    uint64_t gap_max;
+    uint32_t isr_n[NUM_MEDIDOS];
+    uint64_t lat_soma[NUM_MEDIDOS];
+    uint32_t lat_max[NUM_MEDIDOS];
+    uint32_t trocas;
+    uint64_t desligado;             // Ciclos dormindo em POWER_DOWN
+    uint32_t acordadas;             // Bordas que acordaram do POWER_DOWN
+    uint64_t acorda_soma;
+    uint32_t acorda_max;
+} stats_t;
+
+static avr_t *avr;
+static stats_t stats[MAX_EX];
+static uint8_t ex_atual;
+static uint32_t end_loop, end_millis, end_ex;
+static uint8_t isr_ativas;
+static uint64_t boot_ciclos;
+static uint64_t pendente_desde[NUM_VETORES];
+static uint8_t porta_ant[3];
+static uint8_t modo_sono;           // SM2:0 no último SLEEP
+static uint64_t borda_em;           // Borda que pegou a CPU em POWER_DOWN (0 = nenhuma)
+static FILE *trace;
+
+// ================================================================================
+// ROTEIRO DE BOTÕES (Módulo 3) - repete a cada ROTEIRO_MS
+// ================================================================================
+#define ROTEIRO_MS  8000
+
+static const struct { uint16_t t_ms; uint8_t pino; uint8_t apertado; } ROTEIRO[] = {
+    {   50, 2, 1 }, {  130, 2, 0 },     // Clique BTN1
+    {  400, 3, 1 }, {  480, 3, 0 },     // Clique BTN2
+    {  800, 4, 1 }, {  880, 4, 0 },     // Clique BTN3
+    { 1200, 2, 1 }, { 1260, 2, 0 },     // Duplo clique BTN1
+    { 1350, 2, 1 }, { 1410, 2, 0 },
+    { 2000, 2, 1 }, { 7500, 2, 0 },     // Pressão longa BTN1 (5,5s)
+};
+#define ROTEIRO_N   (sizeof(ROTEIRO) / sizeof(ROTEIRO[0]))
+
+static avr_cycle_count_t aplica_botao(avr_t *a, avr_cycle_count_t quando, void *param) {
+    uintptr_t i = (uintptr_t)param;
+    avr_irq_t *irq = avr_io_getirq(a, AVR_IOCTL_IOPORT_GETIRQ('C'), ROTEIRO[i % ROTEIRO_N].pino);
+    if (a->state == cpu_Sleeping && modo_sono == SONO_PWR_DOWN && !borda_em) borda_em = a->cycle;
+    avr_raise_irq(irq, !ROTEIRO[i % ROTEIRO_N].apertado);   // Pull-up: apertado = 0
+    (void)quando;
+    return 0;
+}
+
+static void agenda_roteiro(uint32_t segundos) {
+    for (uint8_t p = 2; p <= 4; p++) {
+        avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('C'), p), 1);
+    }
+    uintptr_t i = 0;
+    for (uint32_t base = 0; base < segundos * 1000UL; base += ROTEIRO_MS) {
+        for (uint8_t k = 0; k < ROTEIRO_N; k++, i++) {
+            uint64_t t = base + ROTEIRO[k].t_ms;
+            if (t >= segundos * 1000UL) break;
+            avr_cycle_timer_register(avr, t * CICLOS_MS, aplica_botao, (void *)i);
+        }
+    }
+}
+
+// ================================================================================
+// NOTIFICAÇÕES (ISRs e portas)
+// ================================================================================
+static void isr_pendente(avr_irq_t *irq, uint32_t valor, void *param) {
+    if (valor) pendente_desde[(uintptr_t)param] = avr->cycle;
+    (void)irq;
+}
+
+static void isr_rodando(avr_irq_t *irq, uint32_t valor, void *param) {
+    uintptr_t v = (uintptr_t)param;
+    (void)irq;
+    if (!valor) {
+        if (isr_ativas) isr_ativas--;
+        return;
+    }
+    isr_ativas++;
+    if (v == VETOR_PCINT1 && borda_em) {
+        stats_t *s = &stats[ex_atual];
+        uint32_t lat = (uint32_t)(avr->cycle - borda_em) + PARTIDA_CK;
+        s->acordadas++;
+        s->acorda_soma += lat;
+        if (lat > s->acorda_max) s->acorda_max = lat;
+        borda_em = 0;
+    }
+    for (uint8_t m = 0; m < NUM_MEDIDOS; m++) {
+        if (VETORES[m].v != v) continue;
+        uint32_t lat = (uint32_t)(avr->cycle - pendente_desde[v]);
+        stats_t *s = &stats[ex_atual];
+        s->isr_n[m]++;
+        s->lat_soma[m] += lat;
+        if (lat > s->lat_max[m]) s->lat_max[m] = lat;
+    }
+}
+
+static void porta_escrita(avr_irq_t *irq, uint32_t valor, void *param) {
+    uintptr_t p = (uintptr_t)param;
+    uint8_t mudou = porta_ant[p] ^ (uint8_t)valor;
+    (void)irq;
+    porta_ant[p] = (uint8_t)valor;
+    stats[ex_atual].trocas += __builtin_popcount(mudou);
+    if (trace && mudou) {
+        fprintf(trace, "%llu,%c,0x%02X\n", (unsigned long long)avr->cycle, 'B' + (int)p, (uint8_t)valor);
+    }
+}
+
+static void uart_saida(avr_irq_t *irq, uint32_t valor, void *param) {
+    (void)irq;
+    (void)param;
+    putchar((int)(valor & 0xFF));
+}
+
+// Módulo 0: bytes da USART0 direto no stdout (sem as linhas "UART0:" do simavr)
+static void conecta_uart(void) {
+    uint32_t flags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), uart_saida, NULL);
+}
+
+static void conecta_irqs(void) {
+    for (uintptr_t v = 1; v < NUM_VETORES; v++) {
+        avr_irq_t *irq = avr_get_interrupt_irq(avr, (uint8_t)v);
+        if (!irq) continue;
+        avr_irq_register_notify(irq + AVR_INT_IRQ_PENDING, isr_pendente, (void *)v);
+        avr_irq_register_notify(irq + AVR_INT_IRQ_RUNNING, isr_rodando, (void *)v);
+    }
+    for (uintptr_t p = 0; p < 3; p++) {
+        avr_irq_t *irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B' + p), IOPORT_IRQ_PIN_ALL);
+        avr_irq_register_notify(irq, porta_escrita, (void *)p);
+    }
+}
+
+// ================================================================================
+// EXECUÇÃO
+// ================================================================================
+static uint16_t palavra(uint32_t pc) {
+    return (uint16_t)(avr->flash[pc] | (avr->flash[pc + 1] << 8));
+}
+
+// Instrução a ser executada: conta loop(), SLEEP e leituras de timer_millis
+static void inspeciona(void) {
+    stats_t *s = &stats[ex_atual];
+    uint32_t pc = avr->pc;
+    uint16_t op = palavra(pc);
+
+    if (end_loop && pc == end_loop) s->loops++;
+    if (op == OP_SLEEP) {
+        s->sleeps++;
+        modo_sono = (avr->data[SMCR_END] >> 1) & 7;
+    }
+    if (!boot_ciclos && (end_loop ? pc == end_loop : op == OP_SLEEP)) boot_ciclos = avr->cycle;
+    if (end_millis && !isr_ativas && (op & OP_LDS_MASK) == OP_LDS && palavra(pc + 2) == end_millis) {
+        if (s->leitura_ant) {
+            uint64_t gap = avr->cycle - s->leitura_ant;
+            if (gap > s->gap_max) s->gap_max = gap;
+        }
+        s->leitura_ant = avr->cycle;
+    }
+}
+
+// ex_forcado: escreve exercicio_atual na 1ª entrada em loop() (Módulo 3)
+static int simula(const char *elf, uint32_t segundos, int ex_forcado, int modulo) {
+    elf_firmware_t f;
+    memset(&f, 0, sizeof(f));
+    if (elf_read_firmware(elf, &f)) {
+        fprintf(stderr, "simavr_bench: não consegui ler %s\n", elf);
+        return -1;
+    }
+    strcpy(f.mmcu, "atmega328p");
+    f.frequency = F_CPU;
+
+    avr = avr_make_mcu_by_name(f.mmcu);
+    if (!avr) return -1;
+    avr_init(avr);
+    avr_load_firmware(avr, &f);
+
+    memset(porta_ant, 0, sizeof(porta_ant));
+    memset(pendente_desde, 0, sizeof(pendente_desde));
+    isr_ativas = 0;
+    modo_sono = 0;
+    borda_em = 0;
+    conecta_irqs();
+    if (modulo == 0) conecta_uart();
+    else agenda_roteiro(segundos);
+
+    uint64_t fim = (uint64_t)segundos * F_CPU;
+    uint8_t forcou = (ex_forcado < 0);
+    int estado = cpu_Running;
+
+    while (avr->cycle < fim && estado != cpu_Done && estado != cpu_Crashed) {
+        if (!forcou && end_loop && avr->pc == end_loop) {
+            avr->data[end_ex] = (uint8_t)ex_forcado;
+            forcou = 1;
+        }
+        if (end_ex) ex_atual = avr->data[end_ex] % MAX_EX;
+        if (ex_forcado >= 0) ex_atual = (uint8_t)ex_forcado;
+
+        uint8_t dormia = (avr->state == cpu_Sleeping);
+        uint8_t em_isr = isr_ativas;
+        uint64_t antes = avr->cycle;
+        if (!dormia) inspeciona();
+        estado = avr_run(avr);
+
+        stats[ex_atual].ciclos += avr->cycle - antes;
+        if (dormia) stats[ex_atual].dormindo += avr->cycle - antes;
+        if (dormia && modo_sono == SONO_PWR_DOWN) stats[ex_atual].desligado += avr->cycle - antes;
+        if (em_isr) stats[ex_atual].em_isr += avr->cycle - antes;
+    }
+    avr_terminate(avr);
+    return 0;
+}
+
+// ================================================================================
+// RELATÓRIO
+// ================================================================================
+static const char *NOMES_M1[10] = { "1.1", "1.2a", "1.2b", "1.2c", "1.2d", "1.2e", "1.2f", "1.2g", "1.2h", "1.2i" };
+static const char *NOMES_M3[11] = { "-", "3.1", "3.2", "3.3", "3.4", "3.5", "3.6", "3.7", "3.8", "3.9", "3.10" };
+
+static void relatorio(int modulo) {
+    uint64_t ciclos = 0, dormindo = 0, em_isr = 0;
+
+    printf("%-6s %8s %8s %8s %6s %6s %10s", "ex", "tempo_ms", "loop/s", "sleep/s", "cpu%", "isr%", "gap_ms_us");
+    for (uint8_t m = 0; m < NUM_MEDIDOS; m++) printf(" %13s", VETORES[m].nome);
+    printf(" %8s %6s %13s\n", "trocas/s", "pd%", "acorda_us");
+
+    for (uint8_t e = 0; e < MAX_EX; e++) {
+        stats_t *s = &stats[e];
+        if (!s->ciclos) continue;
+        double seg = (double)s->ciclos / F_CPU;
+        const char *nome = modulo == 1 && e < 10 ? NOMES_M1[e] :
+                           modulo == 3 && e < 11 ? NOMES_M3[e] : "mux";
+
+        ciclos += s->ciclos;
+        dormindo += s->dormindo;
+        em_isr += s->em_isr;
+
+        printf("%-6s %8.0f %8.0f %8.0f %6.2f %6.2f", nome, seg * 1000.0,
+               s->loops / seg, s->sleeps / seg, 100.0 * (s->ciclos - s->dormindo) / s->ciclos,
+               100.0 * s->em_isr / s->ciclos);
+        if (s->gap_max) printf(" %10.1f", s->gap_max * 1e6 / F_CPU);
+        else printf(" %10s", "-");
+        for (uint8_t m = 0; m < NUM_MEDIDOS; m++) {
+            if (s->isr_n[m]) printf("   %4llu/%4u c", (unsigned long long)(s->lat_soma[m] / s->isr_n[m]), s->lat_max[m]);
+            else printf(" %13s", "-");
+        }
+        printf(" %8.1f %6.2f", s->trocas / seg, 100.0 * s->desligado / s->ciclos);
+        if (s->acordadas) printf("   %5.0f/%5.0f\n", s->acorda_soma * 1e6 / F_CPU / s->acordadas, s->acorda_max * 1e6 / F_CPU);
+        else printf(" %13s\n", "-");
+    }
+    printf("(latência das ISRs: média/máxima em ciclos de CPU)\n");
+    printf("(pd%%: tempo em POWER_DOWN; acorda_us: borda do botão até a ISR PCINT1 + %u CK de partida, média/máxima)\n",
+           PARTIDA_CK);
+    printf("boot: %llu ciclos (%.1f us) até o %s\n", (unsigned long long)boot_ciclos,
+           boot_ciclos * 1e6 / F_CPU, end_loop ? "1º loop()" : "1º SLEEP");
+
+    // Linha para bench/compara.py
+    if (ciclos) {
+        printf("RESUMO boot_ciclos=%llu cpu=%.3f isr=%.3f\n", (unsigned long long)boot_ciclos,
+               100.0 * (ciclos - dormindo) / ciclos, 100.0 * em_isr / ciclos);
+    }
+}
+
+static uint32_t argumento(int argc, char **argv, const char *nome) {
+    size_t n = strlen(nome);
+    for (int i = 4; i < argc; i++) {
+        if (!strncmp(argv[i], nome, n) && argv[i][n] == '=') return (uint32_t)strtoul(argv[i] + n + 1, 0, 0);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "uso: %s <elf> <modulo 0|1|2|3> <segundos> [loop=0x..] [timer_millis=0x..] [exercicio_atual=0x..]\n", argv[0]);
+        return 2;
+    }
+    const char *elf = argv[1];
+    int modulo = atoi(argv[2]);
+    uint32_t segundos = (uint32_t)atoi(argv[3]);
+
+    // Endereços de RAM do avr-nm vêm com o offset 0x800000 do espaço de dados
+    end_loop = argumento(argc, argv, "loop");
+    end_millis = argumento(argc, argv, "timer_millis") & 0xFFFF;
+    end_ex = argumento(argc, argv, "exercicio_atual") & 0xFFFF;
+
+    const char *arq = getenv("BENCH_TRACE");
+    if (arq) trace = fopen(arq, "w");
+
+    printf("== Módulo %d: %u s simulados por execução @ 16MHz ==\n", modulo, segundos);
+    if (modulo == 3) {
+        // Um exercício por execução (o firmware só arma o escolhido)
+        for (int ex = 1; ex <= 10; ex++) {
+            if (simula(elf, segundos, ex, modulo)) return 1;
+        }
+    } else {
+        if (modulo == 2 || modulo == 0) end_ex = 0;
+        if (simula(elf, segundos, -1, modulo)) return 1;
+    }
+    if (modulo) relatorio(modulo);
+    else fflush(stdout);
+
+    if (trace) fclose(trace);
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * ================================================================================
+ * ACORDE - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "acorde.h"
+#include <avr/pgmspace.h>
+
+// Bits de PORTC → índice compacto (i-ésimo botão da máscara = bit i)
+static uint8_t compacta(uint8_t mascara, uint8_t estado) {
+    uint8_t r = 0, i = 0;
+    for (uint8_t b = 1; b; b <<= 1) {
+        if (!(mascara & b)) continue;
+        if (estado & b) r |= (uint8_t)(1 << i);
+        i++;
+    }
+    return r;
+}
+
+static uint8_t bits(uint8_t v) {
+    uint8_t n = 0;
+    for (; v; v &= (uint8_t)(v - 1)) n++;
+    return n;
+}
+
+void acorde_inicia(acorde_t *a, const acorde_entrada_t *tabela, uint8_t n,
+                   uint8_t mascara, uint8_t janela_ms) {
+    // Só os primeiros ACORDE_MAX_BOTOES botões da máscara
+    uint8_t m = 0;
+    for (uint8_t b = 1, k = 0; b && k < ACORDE_MAX_BOTOES; b <<= 1) {
+        if (mascara & b) { m |= b; k++; }
+    }
+    uint8_t conjuntos = (uint8_t)(1 << bits(m));
+
+    // Ação de cada conjunto: a entrada mais específica contida nele
+    for (uint8_t s = 0; s < conjuntos; s++) {
+        uint8_t acao = ACORDE_NADA;
+        int8_t melhor = -1;
+        for (uint8_t i = 0; i < n; i++) {
+            uint8_t e = pgm_read_byte(&tabela[i].botoes);
+            if (e & (uint8_t)~m) continue;      // Botão fora do grupo
+            uint8_t c = compacta(m, e);
+            if ((c & (uint8_t)~s) || (int8_t)bits(c) <= melhor) continue;
+            melhor = (int8_t)bits(c);
+            acao = pgm_read_byte(&tabela[i].acao);
+        }
+        a->acao[s] = acao;
+    }
+
+    // Espera: algum conjunto maior (que ainda pode se formar) muda a ação
+    a->espera = 0;
+    for (uint8_t s = 0; s < conjuntos; s++) {
+        for (uint8_t t = 0; t < conjuntos; t++) {
+            if (t != s && (t & s) == s && a->acao[t] != a->acao[s]) {
+                a->espera |= (uint8_t)(1 << s);
+                break;
+            }
+        }
+    }
+
+    a->mascara = m;
+    a->atual = a->bruto = 0;
+    a->pendente = 0;
+    a->janela = janela_ms;
+}
+
+// Passa a valer o último conjunto recebido
+static uint8_t fecha(acorde_t *a) {
+    a->pendente = 0;
+    if (a->bruto == a->atual) return 0;
+    a->atual = a->bruto;
+    return 1;
+}
+
+uint8_t acorde_muda(acorde_t *a, uint8_t estado, tick16_t t) {
+    uint8_t s = compacta(a->mascara, estado);
+    if (s == a->bruto) return 0;
+    a->bruto = s;
+    // Tudo solto não vira acorde nenhum: fecha na hora
+    if (s == 0 || !((a->espera >> s) & 1)) return fecha(a);
+    if (!a->pendente) {
+        a->pendente = 1;
+        a->desde = t;
+    }
+    return 0;
+}
+
+uint8_t acorde_vence(acorde_t *a, tick16_t agora) {
+    if (!a->pendente || !tick16_venceu(agora, acorde_prazo(a))) return 0;
+    return fecha(a);
+}
@@ -0,0 +1,75 @@
+/*
+ * ================================================================================
+ * ACORDE - COMBINAÇÕES DE BOTÕES COM JANELA DE SIMULTANEIDADE
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * Dois botões "juntos" nunca chegam juntos: entre a primeira e a segunda
+ * borda debounçada passam alguns ms, e quem olha o estado num instante vê
+ * antes a ação de um botão só (LED que pisca antes de apagar, sequência
+ * que dá um passo). Aqui o conjunto de botões só passa a valer quando fica
+ * parado, ou quando a janela fecha:
+ * - Tabela declarativa (PROGMEM) de { conjunto de botões, ação }. O
+ *   conjunto usa os bits de PORTC, como botoes_estado / btn_estado
+ * - Conjunto sem entrada própria fica com a entrada mais específica contida
+ *   nele (mais botões; empate = a primeira da tabela). { 0, ação } casa
+ *   com qualquer conjunto: é o "nenhum botão" e o padrão
+ * - acorde_inicia() resolve todos os 2^n conjuntos uma vez: a ação de cada
+ *   um e se algum conjunto maior muda a ação (então vale esperar)
+ * - acorde_muda(): a cada PRESS/RELEASE. Se nenhum conjunto maior muda a
+ *   ação, fecha na hora (o segundo botão do acorde não espera); senão abre
+ *   a janela, contada da primeira mudança do grupo (atraso máximo = janela)
+ * - acorde_vence(): fecha a janela vencida. O custo por passo é uma
+ *   comparação de tick; a ação é um índice na tabela resolvida
+ * - A janela vale também para soltar: soltar um acorde meio fora de
+ *   tempo não mostra a ação do botão que sobrou. Soltar o último fecha
+ *   na hora
+ * ================================================================================
+ */
+
+#ifndef ACORDE_H
+#define ACORDE_H
+
+#include <stdint.h>
+#include "timebase.h"
+
+#ifndef ACORDE_MAX_BOTOES
+#define ACORDE_MAX_BOTOES   3
+#endif
+
+#define ACORDE_NADA         0xFF    // Nenhuma entrada contida no conjunto
+
+typedef struct {
+    uint8_t botoes;                 // Bits de PORTC
+    uint8_t acao;
+} acorde_entrada_t;
+
+typedef struct {
+    uint8_t acao[1 << ACORDE_MAX_BOTOES];   // Por conjunto (índice compacto)
+    uint8_t espera;                 // Bit i: conjunto i espera a janela
+    uint8_t mascara;                // Botões do grupo (bits de PORTC)
+    uint8_t atual;                  // Conjunto que vale (índice compacto)
+    uint8_t bruto;                  // Último conjunto recebido
+    uint8_t pendente;
+    uint8_t janela;                 // ms
+    tick16_t desde;                 // Primeira mudança da janela aberta
+} acorde_t;
+
+static_assert(ACORDE_MAX_BOTOES <= 3, "acorde_t.espera tem 8 bits");
+
+// n entradas de 'tabela' (PROGMEM); os botões de fora de 'mascara' são
+// ignorados. Começa com nenhum botão valendo
+void acorde_inicia(acorde_t *a, const acorde_entrada_t *tabela, uint8_t n,
+                   uint8_t mascara, uint8_t janela_ms);
+// estado = conjunto pressionado após a borda de tempo t (ev.t).
+// 1 = o conjunto que vale mudou agora
+uint8_t acorde_muda(acorde_t *a, uint8_t estado, tick16_t t);
+// 1 = a janela fechou e o conjunto que vale mudou
+uint8_t acorde_vence(acorde_t *a, tick16_t agora);
+
+static inline uint8_t acorde_acao(const acorde_t *a) { return a->acao[a->atual]; }
+static inline uint8_t acorde_pendente(const acorde_t *a) { return a->pendente; }
+// Deadline para fechar a janela (só com acorde_pendente())
+static inline tick16_t acorde_prazo(const acorde_t *a) { return (tick16_t)(a->desde + a->janela); }
+
+#endif
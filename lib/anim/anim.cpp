@@ -0,0 +1,78 @@
+/*
+ * ================================================================================
+ * ANIM - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "anim.h"
+#include "timebase.h"
+
+static void carrega_passo(anim_t *a) {
+    anim_passo_t p;
+    memcpy_P(&p, a->passo, sizeof(p));
+    a->op = p.op;
+    a->acc = p.valor;
+    a->frames_rest = p.n;
+    a->tempo = p.tempo;
+    a->sobe = !(p.valor & 0x80);
+}
+
+static void emite(anim_t *a) {
+    a->saida(a->acc);
+    a->per.periodo = (uint16_t)a->tempo * ANIM_TICK_MS;
+    sched_per_avanca(&a->per);
+}
+
+void anim_inicia(anim_t *a, const anim_desc_t *desc) {
+    a->desc = desc;
+    a->passo = (const anim_passo_t *)pgm_read_ptr(&desc->passos);
+    a->passos_rest = pgm_read_byte(&desc->n_passos);
+    a->repet_rest = pgm_read_byte(&desc->repeticoes);
+    a->saida = (anim_saida_t)pgm_read_ptr(&desc->saida);
+    a->per.proximo = tick16();
+    carrega_passo(a);
+    emite(a);
+}
+
+uint8_t anim_avanca(anim_t *a) {
+    uint8_t fim = 0;
+    
+    if (--a->frames_rest == 0) {
+        // Passo terminou → próximo passo (ou volta ao início da lista)
+        a->passo++;
+        if (--a->passos_rest == 0) {
+            a->passo = (const anim_passo_t *)pgm_read_ptr(&a->desc->passos);
+            a->passos_rest = pgm_read_byte(&a->desc->n_passos);
+            if (--a->repet_rest == 0) {
+                a->repet_rest = pgm_read_byte(&a->desc->repeticoes);
+                fim = 1;
+            }
+        }
+        carrega_passo(a);
+    } else {
+        uint8_t v = a->acc;
+        switch (a->op) {
+            case ANIM_SHL:     v <<= 1;                 break;
+            case ANIM_SHR:     v >>= 1;                 break;
+            case ANIM_FILL_UP: v = (v << 1) | 0x01;     break;
+            case ANIM_FILL_DN: v = (v >> 1) | 0x80;     break;
+            case ANIM_INC:     v++;                     break;
+            case ANIM_DEC:     v--;                     break;
+            case ANIM_INV:     v = ~v;                  break;
+            case ANIM_BOUNCE:
+                if (a->sobe) {
+                    v <<= 1;
+                    if (v & 0x80) a->sobe = 0;
+                } else {
+                    v >>= 1;
+                    if (v & 0x01) a->sobe = 1;
+                }
+                break;
+            default:                                    break;
+        }
+        a->acc = v;
+    }
+    
+    emite(a);
+    return fim;
+}
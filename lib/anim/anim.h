@@ -0,0 +1,85 @@
+/*
+ * ================================================================================
+ * ANIM - INTERPRETADOR DE ANIMAÇÕES DO BARGRAPH (TABELAS EM PROGMEM)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * Uma animação é uma lista de passos na flash. Cada passo gera 'n' frames de
+ * 8 bits a partir de 'valor' aplicando um operador (shift, fill, contagem,
+ * bounce...). Cada frame fica 'tempo' × ANIM_TICK_MS na saída.
+ * 
+ *   frame 0 = valor, frame k = op(frame k-1)
+ * 
+ * O descritor diz quantas vezes a lista se repete e qual função escreve o
+ * frame no hardware. anim_avanca() retorna 1 ao completar as repetições
+ * (e recomeça do primeiro passo). Custo por frame: constante (1 switch).
+ * 
+ * Os deadlines dos frames avançam pelo tempo nominal (sched_per_t): atraso
+ * de um frame não empurra os seguintes. Período inteiro perdido segue
+ * a->per.politica (escolhida por quem usa; zerado = SCHED_PULA).
+ * ================================================================================
+ */
+
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "scheduler.h"
+
+#define ANIM_TICK_MS    5
+
+// Operadores (frame seguinte a partir do atual)
+#define ANIM_HOLD       0   // Mantém o valor
+#define ANIM_SHL        1   // a << 1
+#define ANIM_SHR        2   // a >> 1
+#define ANIM_FILL_UP    3   // (a << 1) | 0x01
+#define ANIM_FILL_DN    4   // (a >> 1) | 0x80
+#define ANIM_INC        5   // a + 1
+#define ANIM_DEC        6   // a - 1
+#define ANIM_INV        7   // ~a (piscar)
+#define ANIM_BOUNCE     8   // 1 bit indo e voltando entre bit 0 e bit 7
+
+// n = 0 → 256 frames
+#define ANIM_PASSO(op, valor, n, ms)    { (op), (valor), (uint8_t)(n), (uint8_t)((ms) / ANIM_TICK_MS) }
+
+typedef void (*anim_saida_t)(uint8_t frame);
+
+typedef struct {
+    uint8_t op;
+    uint8_t valor;
+    uint8_t n;
+    uint8_t tempo;
+} anim_passo_t;
+
+typedef struct {
+    const anim_passo_t *passos;   // PROGMEM
+    uint8_t n_passos;
+    uint8_t repeticoes;
+    anim_saida_t saida;
+} anim_desc_t;
+
+typedef struct {
+    const anim_desc_t *desc;      // PROGMEM
+    const anim_passo_t *passo;    // PROGMEM
+    anim_saida_t saida;
+    uint8_t passos_rest;
+    uint8_t repet_rest;
+    uint8_t frames_rest;
+    uint8_t op;
+    uint8_t tempo;
+    uint8_t acc;
+    uint8_t sobe;
+    sched_per_t per;              // Deadline do próximo frame (ms)
+} anim_t;
+
+void anim_inicia(anim_t *a, const anim_desc_t *desc);
+uint8_t anim_avanca(anim_t *a);
+
+// O frame na saída é o último da última repetição: quem quer parar no fim
+// (sem escrever o 1º frame de novo) testa isto antes de anim_avanca()
+static inline uint8_t anim_no_fim(const anim_t *a) {
+    return a->frames_rest == 1 && a->passos_rest == 1 && a->repet_rest == 1;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * ================================================================================
+ * ANIM_FRAMES - TABELAS DE FRAMES GERADAS EM TEMPO DE COMPILAÇÃO
+ * ================================================================================
+ * Um gerador é uma struct com:
+ *   static constexpr uint8_t N;                  // nº de frames
+ *   static constexpr uint8_t frame(uint8_t i);   // frame i (função pura)
+ * 
+ * anim_tabela<Gerador>::frames é expandida pelo compilador em um array
+ * PROGMEM { frame(0), frame(1), ..., frame(N-1) } - nenhum cálculo em runtime.
+ * (C++11: sem std::index_sequence, a sequência de índices é gerada aqui)
+ * ================================================================================
+ */
+
+#ifndef ANIM_FRAMES_H
+#define ANIM_FRAMES_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+template<uint8_t... Is> struct anim_seq {};
+
+template<uint8_t N, uint8_t... Is>
+struct anim_gera_seq : anim_gera_seq<N - 1, N - 1, Is...> {};
+
+template<uint8_t... Is>
+struct anim_gera_seq<0, Is...> {
+    typedef anim_seq<Is...> tipo;
+};
+
+template<class G, class S = typename anim_gera_seq<G::N>::tipo>
+struct anim_tabela;
+
+template<class G, uint8_t... Is>
+struct anim_tabela<G, anim_seq<Is...> > {
+    static const uint8_t frames[sizeof...(Is)];
+    static constexpr uint8_t n = sizeof...(Is);
+};
+
+template<class G, uint8_t... Is>
+const uint8_t anim_tabela<G, anim_seq<Is...> >::frames[sizeof...(Is)] PROGMEM = { G::frame(Is)... };
+
+#endif
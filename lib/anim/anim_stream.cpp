@@ -0,0 +1,54 @@
+/*
+ * ================================================================================
+ * ANIM_STREAM - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "anim_stream.h"
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+volatile uint8_t anim_stream_voltas = 0;
+volatile uint8_t anim_stream_fim = 0;
+
+static const uint8_t *s_frame;
+static const uint8_t *s_inicio;
+static const uint8_t *s_fim;
+static uint8_t s_periodo = 0;   // 0 = parado
+static uint8_t s_cont;
+static uint8_t s_voltas;        // 0 = sem fim
+
+void anim_stream_inicia(const uint8_t *frames, uint8_t n, uint8_t periodo_ms, uint8_t voltas) {
+    uint8_t sreg = SREG;
+    cli();
+    s_inicio = frames;
+    s_frame = frames;
+    s_fim = frames + n;
+    s_periodo = periodo_ms;
+    s_cont = 1;                 // Primeiro frame no próximo tick
+    s_voltas = voltas;
+    anim_stream_voltas = 0;
+    anim_stream_fim = 0;
+    SREG = sreg;
+}
+
+void anim_stream_para() {
+    s_periodo = 0;
+}
+
+// Retorna 1 quando há um frame novo em *frame
+uint8_t anim_stream_tick(uint8_t *frame) {
+    if (s_periodo == 0 || --s_cont) return 0;
+    s_cont = s_periodo;
+    if (s_voltas && anim_stream_voltas == s_voltas) {
+        s_periodo = 0;
+        anim_stream_fim = 1;
+        return 0;
+    }
+    *frame = pgm_read_byte(s_frame);
+    if (++s_frame == s_fim) {
+        s_frame = s_inicio;
+        anim_stream_voltas++;
+    }
+    return 1;
+}
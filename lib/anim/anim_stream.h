@@ -0,0 +1,27 @@
+/*
+ * ================================================================================
+ * ANIM_STREAM - REPRODUÇÃO DE FRAMES PELA ISR DE 1ms
+ * ================================================================================
+ * Toca um array de frames da flash, um frame a cada 'periodo_ms' ticks do
+ * Timer1, em loop. anim_stream_tick() deve ser chamada dentro de
+ * timebase_tick_hook() e entrega o frame novo a quem chamou (que decide a
+ * saída); o loop principal não participa (nem acorda).
+ * Com 'voltas' > 0 para sozinho depois do último frame da última volta
+ * ter ficado 'periodo_ms' na saída (nada da volta seguinte é escrito) e
+ * levanta anim_stream_fim.
+ * ================================================================================
+ */
+
+#ifndef ANIM_STREAM_H
+#define ANIM_STREAM_H
+
+#include <stdint.h>
+
+extern volatile uint8_t anim_stream_voltas;  // Quantas vezes a tabela completou
+extern volatile uint8_t anim_stream_fim;     // 1 = parou ao completar as voltas
+
+void anim_stream_inicia(const uint8_t *frames, uint8_t n, uint8_t periodo_ms, uint8_t voltas);
+void anim_stream_para();
+uint8_t anim_stream_tick(uint8_t *frame);
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * ================================================================================
+ * ARENA - ESTADO DOS EXERCÍCIOS SOBREPOSTO NUMA UNION
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * - Cada exercício declara um struct com o seu estado (o que antes era
+ *   'static' dentro da função); o módulo junta todos numa union. Só um
+ *   exercício roda por vez → RAM gasta = maior estado, não a soma
+ * - Ao entrar num exercício: ARENA_ZERA() e, logo depois, os valores
+ *   iniciais diferentes de zero, explicitamente
+ * - ARENA_RELATA(nome, tipo): publica sizeof(tipo) como símbolo absoluto
+ *   "arena_<nome>" no ELF (não ocupa RAM nem flash); scripts/arena.py
+ *   lista esses símbolos depois de cada build
+ * ================================================================================
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string.h>
+
+#define ARENA_ZERA(a)   memset(&(a), 0, sizeof(a))
+
+#ifdef __AVR__
+// Função naked só com diretivas: não gera instrução nenhuma
+#define ARENA_RELATA(nome, tipo)                                            \
+    __attribute__((naked, used)) static void arena_relata_##nome() {        \
+        __asm__ __volatile__ (".global arena_" #nome "\n\t"                 \
+                              ".set arena_" #nome ", %0" :: "n" (sizeof(tipo))); \
+    }
+#else
+#define ARENA_RELATA(nome, tipo)
+#endif
+
+#endif
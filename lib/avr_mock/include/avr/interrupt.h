@@ -0,0 +1,25 @@
+/*
+ * AVR_MOCK - <avr/interrupt.h>: ISRs viram funções extern "C" chamadas
+ * pelo relógio virtual; cli()/sei() mexem só no bit I do SREG simulado
+ */
+
+#ifndef MOCK_AVR_INTERRUPT_H
+#define MOCK_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#ifdef __cplusplus
+#define MOCK_EXTERN_C extern "C"
+#else
+#define MOCK_EXTERN_C
+#endif
+
+#define ISR(vector, ...)        MOCK_EXTERN_C void vector(void); MOCK_EXTERN_C void vector(void)
+#define EMPTY_INTERRUPT(vector) MOCK_EXTERN_C void vector(void); MOCK_EXTERN_C void vector(void) {}
+#define ISR_NOBLOCK
+#define ISR_NAKED
+#define reti()
+#define sei() (SREG |= (uint8_t)(1 << SREG_I))
+#define cli() (SREG &= (uint8_t)~(1 << SREG_I))
+
+#endif
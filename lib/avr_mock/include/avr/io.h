@@ -0,0 +1,140 @@
+/*
+ * AVR_MOCK - <avr/io.h> do ATmega328P com registradores como variáveis
+ * (definidos em mock_avr.cpp). Flags TIFRn/PCIFR: escrever 1 limpa, como
+ * no chip; o relógio virtual é quem seta. UDR0 separa TX de RX.
+ */
+
+#ifndef MOCK_AVR_IO_H
+#define MOCK_AVR_IO_H
+
+#include <stdint.h>
+#include "mock_avr.h"
+
+#define MOCK_REG8(n)  extern volatile uint8_t n;
+#define MOCK_REG16(n) extern volatile uint16_t n;
+
+// UDR0 são dois registradores no mesmo endereço: escrita = transmissão,
+// leitura = último byte recebido (mock_uart_rx)
+struct mock_udr_t {
+    mock_udr_t &operator=(uint8_t c) { mock_uart_escreve(c); return *this; }
+    operator uint8_t() const { return mock_uart_le(); }
+};
+extern mock_udr_t UDR0;
+
+MOCK_REG8(PORTB) MOCK_REG8(PORTC) MOCK_REG8(PORTD) MOCK_REG8(DDRB) MOCK_REG8(DDRC) MOCK_REG8(DDRD)
+MOCK_REG8(PINB) MOCK_REG8(PINC) MOCK_REG8(PIND) MOCK_REG8(MCUCR) MOCK_REG8(SREG) MOCK_REG8(MCUSR)
+MOCK_REG8(TCCR0A) MOCK_REG8(TCCR0B) MOCK_REG8(TCNT0) MOCK_REG8(OCR0A) MOCK_REG8(OCR0B) MOCK_REG8(TIMSK0) MOCK_REG8(TIFR0)
+MOCK_REG8(TCCR1A) MOCK_REG8(TCCR1B) MOCK_REG8(TCCR1C) MOCK_REG16(TCNT1) MOCK_REG16(OCR1A) MOCK_REG16(OCR1B) MOCK_REG16(ICR1) MOCK_REG8(TIMSK1) MOCK_REG8(TIFR1)
+MOCK_REG8(TCCR2A) MOCK_REG8(TCCR2B) MOCK_REG8(TCNT2) MOCK_REG8(OCR2A) MOCK_REG8(OCR2B) MOCK_REG8(TIMSK2) MOCK_REG8(TIFR2) MOCK_REG8(ASSR)
+MOCK_REG8(PCICR) MOCK_REG8(PCIFR) MOCK_REG8(PCMSK0) MOCK_REG8(PCMSK1) MOCK_REG8(PCMSK2)
+MOCK_REG8(UCSR0A) MOCK_REG8(UCSR0B) MOCK_REG8(UCSR0C) MOCK_REG16(UBRR0)
+MOCK_REG8(PRR) MOCK_REG8(SMCR) MOCK_REG8(ADCSRA) MOCK_REG8(ACSR) MOCK_REG8(DIDR0) MOCK_REG8(DIDR1) MOCK_REG8(WDTCSR) MOCK_REG8(GTCCR) MOCK_REG8(GPIOR0)
+
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+#define PUD 4
+#define WGM10 0
+#define WGM11 1
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM12 3
+#define WGM13 4
+#define FOC1B 6
+#define FOC1A 7
+#define TOIE1 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define TOV1 0
+#define OCF1A 1
+#define OCF1B 2
+#define WGM20 0
+#define WGM21 1
+#define COM2B0 4
+#define COM2B1 5
+#define COM2A0 6
+#define COM2A1 7
+#define CS20 0
+#define CS21 1
+#define CS22 2
+#define WGM22 3
+#define FOC2B 6
+#define FOC2A 7
+#define TOIE2 0
+#define TOV2 0
+#define OCIE2A 1
+#define OCIE2B 2
+#define OCF2A 1
+#define OCF2B 2
+#define TOIE0 0
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+#define PCIF0 0
+#define PCIF1 1
+#define PCIF2 2
+#define PCINT8 0
+#define PCINT9 1
+#define PCINT10 2
+#define PCINT11 3
+#define PCINT12 4
+#define PCINT13 5
+#define PCINT14 6
+#define MPCM0 0
+#define U2X0 1
+#define UDRE0 5
+#define TXC0 6
+#define RXC0 7
+#define TXB80 0
+#define UCSZ02 2
+#define TXEN0 3
+#define RXEN0 4
+#define UDRIE0 5
+#define TXCIE0 6
+#define RXCIE0 7
+#define UCSZ00 1
+#define UCSZ01 2
+#define PRADC 0
+#define PRUSART0 1
+#define PRSPI 2
+#define PRTIM1 3
+#define PRTIM0 5
+#define PRTIM2 6
+#define PRTWI 7
+#define SE 0
+#define SM0 1
+#define SM1 2
+#define SM2 3
+#define ADEN 7
+#define ACD 7
+#define SREG_I 7
+#define _BV(b) (1 << (b))
+#define bit_is_set(r,b) ((r) & _BV(b))
+#define bit_is_clear(r,b) (!((r) & _BV(b)))
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * AVR_MOCK - <avr/pgmspace.h>: no host flash e RAM são o mesmo espaço
+ */
+
+#ifndef MOCK_AVR_PGMSPACE_H
+#define MOCK_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)             (s)
+#define pgm_read_byte(a)    (*(const uint8_t *)(a))
+#define pgm_read_word(a)    (*(const uint16_t *)(a))
+#define pgm_read_dword(a)   (*(const uint32_t *)(a))
+#define pgm_read_ptr(a)     (*(void * const *)(a))
+#define memcpy_P            memcpy
+
+#endif
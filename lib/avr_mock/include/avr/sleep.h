@@ -0,0 +1,25 @@
+/*
+ * AVR_MOCK - <avr/sleep.h>: sleep_cpu() avança o relógio virtual até a
+ * próxima interrupção (em qualquer modo de sleep)
+ */
+
+#ifndef MOCK_AVR_SLEEP_H
+#define MOCK_AVR_SLEEP_H
+
+#include <avr/io.h>
+
+#define SLEEP_MODE_IDLE         (0x00 << 1)
+#define SLEEP_MODE_ADC          (0x01 << 1)
+#define SLEEP_MODE_PWR_DOWN     (0x02 << 1)
+#define SLEEP_MODE_PWR_SAVE     (0x03 << 1)
+#define SLEEP_MODE_STANDBY      (0x06 << 1)
+#define SLEEP_MODE_EXT_STANDBY  (0x07 << 1)
+
+#define set_sleep_mode(m)   (SMCR = (uint8_t)((SMCR & ~((1 << SM2) | (1 << SM1) | (1 << SM0))) | (m)))
+#define sleep_enable()      (SMCR |= (uint8_t)(1 << SE))
+#define sleep_disable()     (SMCR &= (uint8_t)~(1 << SE))
+#define sleep_cpu()         mock_dorme()
+#define sleep_bod_disable() ((void)0)      // BODS/BODSE: sem efeito no mock
+#define sleep_mode()        do { sleep_enable(); sleep_cpu(); sleep_disable(); } while (0)
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * ================================================================================
+ * AVR_MOCK - ATmega328P SIMULADO NO HOST (env:native)
+ * ================================================================================
+ * - PORTx/DDRx/PINx/TCNTx/... são variáveis comuns (instrumentáveis nos testes)
+ * - Relógio virtual em ciclos de CPU (F_CPU): Timer1 e Timer2 contam de
+ *   acordo com TCCRnB (prescaler) e modo CTC, setando OCFnA/OCFnB
+ * - Saídas de compare OC1A (PB1) e OC2B (PD3): o compare aplica o modo
+ *   COMnx (troca/zera/seta) no latch do pino; mock_saida_b/d() dão o nível
+ *   dos pinos (PORTx, exceto onde o OCnx está conectado)
+ * - Interrupções habilitadas (bit I do SREG + máscara) são chamadas pelo
+ *   próprio relógio virtual; o código do firmware roda em tempo zero
+ * - sleep_cpu() avança o relógio até a próxima interrupção; em POWER_DOWN
+ *   os timers param e só a PCINT1 (ou mock_limite_sono()) acorda
+ * - USART0: bytes escritos em UDR0 vão para mock_uart_tx()
+ * ================================================================================
+ */
+
+#ifndef MOCK_AVR_H
+#define MOCK_AVR_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void mock_reset(void);                      // Zera registradores e relógio
+uint64_t mock_ciclos(void);                 // Ciclos virtuais desde mock_reset()
+void mock_avanca_ciclos(uint64_t ciclos);   // Avança o relógio disparando ISRs
+void mock_avanca_us(uint32_t us);
+void mock_avanca_ms(uint32_t ms);
+void mock_dorme(void);                      // sleep_cpu(): até a próxima ISR
+void mock_pinc(uint8_t valor);              // Muda PINC (dispara PCINT1)
+uint32_t mock_dormidas(void);               // Quantas vezes sleep_cpu() foi chamada
+uint32_t mock_desligadas(void);             // Quantas delas em POWER_DOWN
+void mock_limite_sono(uint64_t ciclo);      // sleep_cpu() não passa deste ciclo (0 = sem)
+uint8_t mock_saida_b(void);                 // PORTB com OC1A no PB1 se conectado
+uint8_t mock_saida_d(void);                 // PORTD com OC2B no PD3 se conectado
+uint16_t mock_uart_tx(uint8_t *buf, uint16_t max);  // Retira bytes já transmitidos
+void mock_uart_rx(uint8_t c);               // Byte recebido (UDR0 + RXC0)
+
+// Acessos a UDR0 (usados por mock_udr_t)
+void mock_uart_escreve(uint8_t c);
+uint8_t mock_uart_le(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
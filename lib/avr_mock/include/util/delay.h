@@ -0,0 +1,13 @@
+/*
+ * AVR_MOCK - <util/delay.h>: as esperas consomem tempo virtual
+ */
+
+#ifndef MOCK_UTIL_DELAY_H
+#define MOCK_UTIL_DELAY_H
+
+#include "mock_avr.h"
+
+#define _delay_us(us)   mock_avanca_us((uint32_t)(us))
+#define _delay_ms(ms)   mock_avanca_ms((uint32_t)(ms))
+
+#endif
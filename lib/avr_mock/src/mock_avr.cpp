@@ -0,0 +1,345 @@
+/*
+ * ================================================================================
+ * AVR_MOCK - REGISTRADORES E RELÓGIO VIRTUAL
+ * ================================================================================
+ * O relógio anda de borda em borda dos prescalers (como o prescaler comum
+ * do chip, um timer com prescaler N conta nos ciclos múltiplos de N).
+ * A cada contagem:
+ *   - TCNTn == OCRnA/OCRnB → OCFnA/OCFnB no clock seguinte (em CTC a flag A
+ *     sobe junto com o TCNTn voltando a 0, igual ao diagrama do datasheet)
+ *   - flag + máscara + bit I → ISR chamada na hora (latência zero)
+ * USART0: cada escrita em UDR0 entrega 1 byte ao buffer do teste e zera
+ * UDRE0 e TXC0, que só voltam depois do tempo de 10 bits no baud de
+ * UBRR0/U2X0 (o "escrever 1 limpa" do TXC0 não é visível numa variável:
+ * a escrita em UDR0 faz esse papel).
+ * SLEEP em POWER_DOWN: sem clock de I/O, Timer1/Timer2 não contam; só
+ * mock_pinc() (PCINT1) acorda, ou o limite de mock_limite_sono().
+ * ================================================================================
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <string.h>
+
+#define MOCK_REG8_DEF(n)  volatile uint8_t n;
+#define MOCK_REG16_DEF(n) volatile uint16_t n;
+
+MOCK_REG8_DEF(PORTB) MOCK_REG8_DEF(PORTC) MOCK_REG8_DEF(PORTD)
+MOCK_REG8_DEF(DDRB) MOCK_REG8_DEF(DDRC) MOCK_REG8_DEF(DDRD)
+MOCK_REG8_DEF(PINB) MOCK_REG8_DEF(PINC) MOCK_REG8_DEF(PIND)
+MOCK_REG8_DEF(MCUCR) MOCK_REG8_DEF(SREG) MOCK_REG8_DEF(MCUSR)
+MOCK_REG8_DEF(TCCR0A) MOCK_REG8_DEF(TCCR0B) MOCK_REG8_DEF(TCNT0) MOCK_REG8_DEF(OCR0A) MOCK_REG8_DEF(OCR0B)
+MOCK_REG8_DEF(TIMSK0) MOCK_REG8_DEF(TIFR0)
+MOCK_REG8_DEF(TCCR1A) MOCK_REG8_DEF(TCCR1B) MOCK_REG8_DEF(TCCR1C)
+MOCK_REG16_DEF(TCNT1) MOCK_REG16_DEF(OCR1A) MOCK_REG16_DEF(OCR1B) MOCK_REG16_DEF(ICR1)
+MOCK_REG8_DEF(TIMSK1) MOCK_REG8_DEF(TIFR1)
+MOCK_REG8_DEF(TCCR2A) MOCK_REG8_DEF(TCCR2B) MOCK_REG8_DEF(TCNT2) MOCK_REG8_DEF(OCR2A) MOCK_REG8_DEF(OCR2B)
+MOCK_REG8_DEF(TIMSK2) MOCK_REG8_DEF(TIFR2) MOCK_REG8_DEF(ASSR)
+MOCK_REG8_DEF(PCICR) MOCK_REG8_DEF(PCIFR) MOCK_REG8_DEF(PCMSK0) MOCK_REG8_DEF(PCMSK1) MOCK_REG8_DEF(PCMSK2)
+MOCK_REG8_DEF(UCSR0A) MOCK_REG8_DEF(UCSR0B) MOCK_REG8_DEF(UCSR0C) MOCK_REG16_DEF(UBRR0)
+mock_udr_t UDR0;
+MOCK_REG8_DEF(PRR) MOCK_REG8_DEF(SMCR) MOCK_REG8_DEF(ADCSRA) MOCK_REG8_DEF(ACSR)
+MOCK_REG8_DEF(DIDR0) MOCK_REG8_DEF(DIDR1) MOCK_REG8_DEF(WDTCSR) MOCK_REG8_DEF(GTCCR) MOCK_REG8_DEF(GPIOR0)
+
+// Vetores sem ISR no firmware testado ficam com o handler vazio
+#define MOCK_VETOR(v) extern "C" void v(void) __attribute__((weak)); extern "C" void v(void) {}
+
+MOCK_VETOR(PCINT1_vect)
+MOCK_VETOR(TIMER2_COMPA_vect)
+MOCK_VETOR(TIMER2_COMPB_vect)
+MOCK_VETOR(TIMER2_OVF_vect)
+MOCK_VETOR(TIMER1_COMPA_vect)
+MOCK_VETOR(TIMER1_COMPB_vect)
+MOCK_VETOR(TIMER1_OVF_vect)
+MOCK_VETOR(USART_UDRE_vect)
+
+static uint64_t ciclos;
+static uint32_t isrs;       // ISRs atendidas (sleep_cpu acorda na próxima)
+static uint32_t dormidas;
+static uint32_t desligadas;
+static uint8_t desligado;       // Dentro de um SLEEP em POWER_DOWN
+static uint64_t limite_sono;    // 0 = só o limite de 10 s
+
+// Latches das saídas de compare (nível do pino quando COMnx != 0)
+static uint8_t oc1a, oc2b;
+
+// COMnx1:0 em modo não-PWM: 01 troca, 10 zera, 11 seta
+static void aplica_com(uint8_t *latch, uint8_t com) {
+    if (com == 1) *latch ^= 1;
+    else if (com == 2) *latch = 0;
+    else if (com == 3) *latch = 1;
+}
+
+// Último valor das flags escrito pelo mock: bit 1 que aparece sem o mock
+// ter setado é um "escrever 1 para limpar" do firmware
+static uint8_t tifr1_mock, tifr2_mock, pcifr_mock;
+
+#define MOCK_UART_N 1024
+static uint8_t uart_tx[MOCK_UART_N];
+static uint16_t uart_tx_n;
+static uint64_t uart_livre_em;      // Ciclo em que UDRE0 (e TXC0) voltam a 1
+static uint8_t uart_em_voo;         // Byte na linha: TXC0 sobe quando sair
+static uint8_t uart_rx;
+
+static void sincroniza_flags(volatile uint8_t *reg, uint8_t *espelho) {
+    uint8_t escritos = *reg & (uint8_t)~*espelho;
+    *reg &= (uint8_t)~escritos;
+    *espelho = *reg;
+}
+
+static void seta_flag(volatile uint8_t *reg, uint8_t *espelho, uint8_t bit) {
+    sincroniza_flags(reg, espelho);
+    *reg |= (uint8_t)(1 << bit);
+    *espelho = *reg;
+}
+
+// Ciclos por contagem, 0 = timer parado
+static uint16_t prescaler1(void) {
+    if (desligado || (PRR & (1 << PRTIM1))) return 0;
+    static const uint16_t div[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };  // 6/7: clock externo
+    return div[TCCR1B & 0x07];
+}
+
+static uint16_t prescaler2(void) {
+    if (desligado || (PRR & (1 << PRTIM2))) return 0;
+    static const uint16_t div[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+    return div[TCCR2B & 0x07];
+}
+
+static void conta_timer1(void) {
+    uint16_t t = TCNT1;
+    uint8_t ctc = (TCCR1B & (1 << WGM12)) && !(TCCR1B & (1 << WGM13));
+    uint16_t top = ctc ? OCR1A : 0xFFFF;
+
+    if (t == OCR1A) {
+        aplica_com(&oc1a, (TCCR1A >> COM1A0) & 3);
+        seta_flag(&TIFR1, &tifr1_mock, OCF1A);
+    }
+    if (t == OCR1B) seta_flag(&TIFR1, &tifr1_mock, OCF1B);
+    if (t == top) {
+        TCNT1 = 0;
+        if (!ctc) seta_flag(&TIFR1, &tifr1_mock, TOV1);
+    } else {
+        TCNT1 = (uint16_t)(t + 1);
+    }
+}
+
+static void conta_timer2(void) {
+    uint8_t t = TCNT2;
+    uint8_t ctc = (TCCR2A & (1 << WGM21)) && !(TCCR2B & (1 << WGM22));
+    uint8_t top = ctc ? OCR2A : 0xFF;
+
+    if (t == OCR2A) seta_flag(&TIFR2, &tifr2_mock, OCF2A);
+    if (t == OCR2B) {
+        aplica_com(&oc2b, (TCCR2A >> COM2B0) & 3);
+        seta_flag(&TIFR2, &tifr2_mock, OCF2B);
+    }
+    if (t == top) {
+        TCNT2 = 0;
+        if (!ctc) seta_flag(&TIFR2, &tifr2_mock, TOV2);
+    } else {
+        TCNT2 = (uint8_t)(t + 1);
+    }
+}
+
+// Chama a ISR se flag, máscara e bit I permitirem (flag limpa pelo hardware
+// ao entrar, bit I restaurado pelo reti)
+static uint8_t atende(volatile uint8_t *flags, uint8_t *espelho, uint8_t mascara,
+                      uint8_t bit, void (*isr)(void)) {
+    sincroniza_flags(flags, espelho);
+    if (!(SREG & (1 << SREG_I))) return 0;
+    if (!(*flags & mascara & (1 << bit))) return 0;
+    *flags &= (uint8_t)~(1 << bit);
+    *espelho = *flags;
+    SREG &= (uint8_t)~(1 << SREG_I);
+    isr();
+    SREG |= (uint8_t)(1 << SREG_I);
+    isrs++;
+    return 1;
+}
+
+static uint32_t ciclos_por_byte(void) {
+    uint32_t div = (UCSR0A & (1 << U2X0)) ? 8 : 16;
+    return 10UL * div * (UBRR0 + 1UL);
+}
+
+static void atualiza_udre(void) {
+    if (ciclos < uart_livre_em) return;
+    UCSR0A |= (1 << UDRE0);
+    if (uart_em_voo) UCSR0A |= (1 << TXC0);
+    uart_em_voo = 0;
+}
+
+static uint8_t atende_udre(void) {
+    atualiza_udre();
+    if (!(SREG & (1 << SREG_I))) return 0;
+    if (!(UCSR0B & (1 << UDRIE0)) || !(UCSR0A & (1 << UDRE0))) return 0;
+    SREG &= (uint8_t)~(1 << SREG_I);
+    USART_UDRE_vect();
+    SREG |= (uint8_t)(1 << SREG_I);
+    isrs++;
+    return 1;
+}
+
+// Ordem da tabela de vetores (menor endereço = maior prioridade)
+static void atende_pendentes(void) {
+    uint8_t atendeu;
+    do {
+        atendeu = atende(&PCIFR, &pcifr_mock, PCICR, PCIF1, PCINT1_vect) ||
+                  atende(&TIFR2, &tifr2_mock, TIMSK2, OCF2A, TIMER2_COMPA_vect) ||
+                  atende(&TIFR2, &tifr2_mock, TIMSK2, OCF2B, TIMER2_COMPB_vect) ||
+                  atende(&TIFR2, &tifr2_mock, TIMSK2, TOV2,  TIMER2_OVF_vect) ||
+                  atende(&TIFR1, &tifr1_mock, TIMSK1, OCF1A, TIMER1_COMPA_vect) ||
+                  atende(&TIFR1, &tifr1_mock, TIMSK1, OCF1B, TIMER1_COMPB_vect) ||
+                  atende(&TIFR1, &tifr1_mock, TIMSK1, TOV1,  TIMER1_OVF_vect) ||
+                  atende_udre();
+    } while (atendeu);
+}
+
+static uint64_t proxima_borda(uint16_t div) {
+    return (ciclos / div + 1) * div;
+}
+
+// Avança até a próxima contagem de algum timer (ou até 'limite')
+static void passo(uint64_t limite) {
+    uint16_t d1 = prescaler1();
+    uint16_t d2 = prescaler2();
+    uint64_t alvo = limite;
+
+    if (d1 && proxima_borda(d1) < alvo) alvo = proxima_borda(d1);
+    if (d2 && proxima_borda(d2) < alvo) alvo = proxima_borda(d2);
+    if (uart_livre_em > ciclos && uart_livre_em < alvo) alvo = uart_livre_em;
+    ciclos = alvo;
+
+    if (d1 && ciclos % d1 == 0) conta_timer1();
+    if (d2 && ciclos % d2 == 0) conta_timer2();
+    atende_pendentes();
+}
+
+extern "C" {
+
+void mock_reset(void) {
+    PORTB = PORTC = PORTD = 0;
+    DDRB = DDRC = DDRD = 0;
+    PINB = PINC = PIND = 0xFF;      // Entradas em nível alto (pull-ups)
+    MCUCR = SREG = MCUSR = 0;
+    TCCR0A = TCCR0B = TCNT0 = OCR0A = OCR0B = TIMSK0 = TIFR0 = 0;
+    TCCR1A = TCCR1B = TCCR1C = 0;
+    TCNT1 = OCR1A = OCR1B = ICR1 = 0;
+    TIMSK1 = TIFR1 = 0;
+    TCCR2A = TCCR2B = TCNT2 = OCR2A = OCR2B = TIMSK2 = TIFR2 = ASSR = 0;
+    PCICR = PCIFR = PCMSK0 = PCMSK1 = PCMSK2 = 0;
+    UCSR0A = (1 << UDRE0);
+    UCSR0B = 0;
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+    UBRR0 = 0;
+    uart_rx = 0;
+    PRR = SMCR = ADCSRA = ACSR = DIDR0 = DIDR1 = WDTCSR = GTCCR = GPIOR0 = 0;
+
+    tifr1_mock = tifr2_mock = pcifr_mock = 0;
+    oc1a = oc2b = 0;
+    uart_tx_n = 0;
+    uart_livre_em = 0;
+    uart_em_voo = 0;
+    ciclos = 0;
+    isrs = 0;
+    dormidas = 0;
+    desligadas = 0;
+    desligado = 0;
+    limite_sono = 0;
+}
+
+uint64_t mock_ciclos(void) {
+    return ciclos;
+}
+
+void mock_avanca_ciclos(uint64_t n) {
+    uint64_t limite = ciclos + n;
+    atende_pendentes();
+    while (ciclos < limite) passo(limite);
+}
+
+void mock_avanca_us(uint32_t us) {
+    mock_avanca_ciclos((uint64_t)us * (F_CPU / 1000000UL));
+}
+
+void mock_avanca_ms(uint32_t ms) {
+    mock_avanca_ciclos((uint64_t)ms * (F_CPU / 1000UL));
+}
+
+// Sem nenhuma fonte de interrupção o chip dormiria para sempre: o mock
+// desiste após 10 s virtuais (ou em mock_limite_sono()) para o teste poder
+// seguir ou acusar o travamento
+void mock_dorme(void) {
+    uint32_t antes = isrs;
+    uint64_t limite = ciclos + 10ULL * F_CPU;
+    if (limite_sono > ciclos && limite_sono < limite) limite = limite_sono;
+
+    dormidas++;
+    desligado = ((SMCR >> SM0) & 7) == (SLEEP_MODE_PWR_DOWN >> 1);
+    if (desligado) desligadas++;
+    atende_pendentes();
+    while (isrs == antes && ciclos < limite) passo(limite);
+    desligado = 0;
+}
+
+void mock_limite_sono(uint64_t ciclo) {
+    limite_sono = ciclo;
+}
+
+uint32_t mock_desligadas(void) {
+    return desligadas;
+}
+
+void mock_pinc(uint8_t valor) {
+    uint8_t mudou = PINC ^ valor;
+    PINC = valor;
+    if ((PCICR & (1 << PCIE1)) && (mudou & PCMSK1)) {
+        seta_flag(&PCIFR, &pcifr_mock, PCIF1);
+    }
+    atende_pendentes();
+}
+
+uint8_t mock_saida_b(void) {
+    if (!(TCCR1A & (3 << COM1A0))) return PORTB;
+    return (uint8_t)((PORTB & ~(1 << PB1)) | (oc1a << PB1));
+}
+
+uint8_t mock_saida_d(void) {
+    if (!(TCCR2A & (3 << COM2B0))) return PORTD;
+    return (uint8_t)((PORTD & ~(1 << PD3)) | (oc2b << PD3));
+}
+
+uint16_t mock_uart_tx(uint8_t *buf, uint16_t max) {
+    uint16_t n = uart_tx_n < max ? uart_tx_n : max;
+    memcpy(buf, uart_tx, n);
+    memmove(uart_tx, uart_tx + n, uart_tx_n - n);
+    uart_tx_n -= n;
+    return n;
+}
+
+void mock_uart_rx(uint8_t c) {
+    uart_rx = c;
+    UCSR0A |= (1 << RXC0);
+}
+
+// Sem TXEN0 o byte não sai; UDRE0 cai até o shift register liberar
+void mock_uart_escreve(uint8_t c) {
+    if (!(UCSR0B & (1 << TXEN0))) return;
+    if (uart_tx_n < MOCK_UART_N) uart_tx[uart_tx_n++] = c;
+    UCSR0A &= (uint8_t)~((1 << UDRE0) | (1 << TXC0));
+    uart_em_voo = 1;
+    uart_livre_em = ciclos + ciclos_por_byte();
+}
+
+uint8_t mock_uart_le(void) {
+    UCSR0A &= (uint8_t)~(1 << RXC0);
+    return uart_rx;
+}
+
+uint32_t mock_dormidas(void) {
+    return dormidas;
+}
+
+}
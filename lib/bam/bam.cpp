@@ -0,0 +1,129 @@
+/*
+ * ================================================================================
+ * BAM - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "bam.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+#include "timer2.h"
+
+volatile uint8_t bam_quadros = 0;
+
+// round(255 * (i / 255)^2.2): o olho percebe brilho quase em log, sem a
+// correção a metade de baixo da escala pareceria toda "acesa"
+static const uint8_t GAMMA[256] PROGMEM = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+static uint8_t s_quadros[2][BAM_CANAIS];    // Planos 0-7 de cada buffer
+static uint8_t *s_frente;                   // Lido pela ISR
+static uint8_t *s_tras;                     // Escrito por bam_publica()
+static volatile uint8_t s_pendente;
+static const uint8_t *s_plano;              // Próximo plano a ir para PORTB
+static uint8_t s_dur;                       // Contagens do plano (2..128, 0 = 256)
+
+static void bam_plano();
+
+uint8_t bam_gamma(uint8_t brilho) {
+    return pgm_read_byte(&GAMMA[brilho]);
+}
+
+void bam_inicia() {
+    uint8_t sreg = SREG;
+    cli();
+    TIMSK2 &= ~(1 << OCIE2B);
+    memset(s_quadros, 0, sizeof(s_quadros));
+    s_frente = s_quadros[0];
+    s_tras = s_quadros[1];
+    s_pendente = 0;
+    s_plano = s_frente;
+    s_dur = 2;
+    TCCR2A = 0;                             // Modo normal: conta 0-255 livre
+    TCCR2B = (1 << CS22) | (1 << CS21);     // Prescaler 256
+    TCNT2 = 0;
+    OCR2B = 1;                              // Primeiro plano logo em seguida
+    TIFR2 = (1 << OCF2B);
+    timer2_compb(bam_plano);
+    TIMSK2 |= (1 << OCIE2B);
+    SREG = sreg;
+}
+
+// Para o Timer2 e apaga o bargraph
+void bam_para() {
+    uint8_t sreg = SREG;
+    cli();
+    TIMSK2 &= ~(1 << OCIE2B);
+    TCCR2B = 0;
+    TIFR2 = (1 << OCF2B);
+    PORTB = 0;
+    SREG = sreg;
+}
+
+// Monta o quadro no buffer de trás. O pendente é baixado antes: a ISR não
+// troca os buffers no meio da escrita (e, se acabou de trocar, o de trás é
+// o que ela deixou de mostrar)
+void bam_publica(const uint8_t brilho[BAM_CANAIS]) {
+    uint8_t sreg = SREG;
+    cli();
+    s_pendente = 0;
+    uint8_t *p = s_tras;
+    SREG = sreg;
+
+    memset(p, 0, BAM_CANAIS);
+    uint8_t mascara = 1;
+    for (uint8_t c = 0; c < BAM_CANAIS; c++) {
+        uint8_t g = pgm_read_byte(&GAMMA[brilho[c]]);
+        for (uint8_t k = 0; g; k++, g >>= 1) {
+            if (g & 1) p[k] |= mascara;
+        }
+        mascara <<= 1;
+    }
+
+    s_pendente = 1;
+}
+
+// Um plano por compare B (chamado pela ISR de lib/timer2). Caminho
+// comum: ~10 instruções
+static void bam_plano() {
+    const uint8_t *p = s_plano;
+    uint8_t d = s_dur;
+
+    PORTB = *p++;
+    OCR2B += d;
+    if (d) {
+        s_dur = d << 1;
+        s_plano = p;
+        return;
+    }
+
+    // Plano 7 (256 contagens) na saída: o quadro seguinte começa no compare
+    // que vem, já com o buffer novo se houver um pendente
+    if (s_pendente) {
+        uint8_t *t = s_frente;
+        s_frente = s_tras;
+        s_tras = t;
+        s_pendente = 0;
+    }
+    s_plano = s_frente;
+    s_dur = 2;
+    bam_quadros++;
+}
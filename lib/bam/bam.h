@@ -0,0 +1,54 @@
+/*
+ * ================================================================================
+ * BAM - BRILHO POR BIT ANGLE MODULATION NO BARGRAPH (PORTB, Timer2)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * 8 LEDs com 256 níveis de brilho cada, sem comparar canal por canal a cada
+ * tick como um PWM em software:
+ * - O quadro vira 8 "planos de bit": o plano k é o byte de PORTB com o bit k
+ *   do brilho (já corrigido por gamma) de cada LED, e fica na saída por
+ *   2^k unidades de tempo. Soma dos planos = brilho exato
+ * - Timer2 em modo normal (contando livre), prescaler 256 → 16µs/contagem.
+ *   O compare B (ISR de lib/timer2) copia um plano para PORTB e soma a duração do plano
+ *   em OCR2B (2, 4, ... 128 e 256 contagens, 256 ≡ +0 em 8 bits). A duração
+ *   é contada a partir do compare anterior, não da entrada na ISR: latência
+ *   de outras interrupções não distorce o brilho
+ * - Quadro = 510 contagens = 8,16ms (~122Hz); 8 ISRs por quadro
+ * - Custo estimado pela contagem de instruções (não medido): ~25 ciclos
+ *   de corpo + ~40 de entrada/prólogo/epílogo/reti + ~30 da chamada
+ *   indireta de lib/timer2 por plano ≈ 760 ciclos a cada 130560 (~0,6% da
+ *   CPU), fixo, qualquer que seja o conteúdo. Um PWM de 256 níveis a
+ *   122Hz pediria uma ISR a 31kHz comparando os 8 canais (~20% da CPU).
+ *   Estimativa, ainda não medida: pio run -e modulo1 -t bench (1.2c/1.2d:
+ *   isr% e latência de T2_COMPB), tabela em bench/RESULTADOS.md
+ * - Limite: o plano mais curto dura 32µs (512 ciclos); uma ISR atrasada mais
+ *   que isso perde o compare e aquele plano dura um giro a mais do Timer2
+ *   (um quadro com brilho errado, sem travar)
+ *   Por isso bam_publica() (~500 ciclos) não deve ser chamada de ISR
+ * - Quadro duplo: bam_publica() aplica o gamma (tabela na flash), monta os
+ *   planos no buffer de trás e marca pendente; a ISR só troca os buffers no
+ *   fim de um quadro → nunca mostra meio quadro antigo, meio novo
+ * - Usa OCR2B/OCIE2B: bam_inicia() registra o tratador em lib/timer2, dona
+ *   do vetor. O modo do Timer2 é um só: um de cada vez com a multiplexação
+ *   (Módulo 2) e com o pisca do PD3 (lib/led, que também usa o compare B)
+ * ================================================================================
+ */
+
+#ifndef BAM_H
+#define BAM_H
+
+#include <stdint.h>
+
+#define BAM_CANAIS          8
+#define BAM_CONTAGENS       510     // Contagens do Timer2 por quadro (2 + 4 + ... + 256)
+#define BAM_US_CONTAGEM     16      // Prescaler 256 @ 16MHz
+
+extern volatile uint8_t bam_quadros;        // +1 quando o último plano vai para a saída
+
+void bam_inicia();
+void bam_para();
+void bam_publica(const uint8_t brilho[BAM_CANAIS]);
+uint8_t bam_gamma(uint8_t brilho);
+
+#endif
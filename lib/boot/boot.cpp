@@ -0,0 +1,27 @@
+/*
+ * ================================================================================
+ * BOOT - IMPLEMENTAÇÃO (só no build bare-metal para o AVR)
+ * ================================================================================
+ */
+
+#include "boot.h"
+
+#if defined(__AVR__) && !defined(ARDUINO)
+
+#include <avr/io.h>
+#include <avr/wdt.h>
+
+// Roda antes de .data/.bss e de main(): um reset por watchdog deixa o WDT
+// ligado com o timeout mínimo, então ele é desligado antes de qualquer coisa
+void boot_init3() __attribute__((naked, used, section(".init3")));
+void boot_init3() {
+    MCUSR = 0;
+    wdt_disable();
+}
+
+int main() {
+    setup();
+    for (;;) loop();
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * ================================================================================
+ * BOOT - setup()/loop() COM OU SEM O CORE ARDUINO
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * - framework = arduino: inclui <Arduino.h> (setup/loop com ligação C,
+ *   chamados pelo main() do core, que antes roda init(): Timer0 + ISR de
+ *   overflow, PWM dos Timers 1/2, ADC ligado)
+ * - Bare (ambientes bare_*, sem framework): boot.cpp fornece o main() e
+ *   não configura periférico nenhum - cada módulo inicia só o que usa
+ * - Inicialização mínima em .init3 (MCUSR e watchdog), independente do
+ *   main(): continua valendo com um crt próprio (-nostartfiles)
+ * ================================================================================
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+void setup();
+void loop() __attribute__((noinline));     // Continua símbolo com LTO (bench)
+#endif
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * ================================================================================
+ * BOTOES - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "botoes.h"
+#include "timebase.h"
+#include "trace.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// Impede o compilador de reordenar acessos à fila em torno dos índices
+#define BARREIRA()  __asm__ __volatile__ ("" ::: "memory")
+
+volatile uint8_t botoes_estado = 0;
+volatile uint8_t botoes_perdidos = 0;
+
+uint16_t botoes_clique_max_ms = 500;
+uint16_t botoes_duplo_ms = 300;
+uint16_t botoes_longo_ms = 1000;
+
+static uint8_t mascara_botoes = 0;
+static uint8_t ct0 = 0xFF;          // Contador vertical (bit menos significativo)
+static uint8_t ct1 = 0xFF;          // Contador vertical (bit mais significativo)
+static uint8_t divisor = BOTOES_DIV_TICKS;
+static volatile uint8_t mudou = 0;
+
+// Classificador (só acessado na ISR)
+static uint16_t t_pressao[BOTOES_MAX_PINOS];
+static uint16_t t_clique[BOTOES_MAX_PINOS];
+static uint8_t longo_emitido = 0;
+static uint8_t clique_pendente = 0;
+
+// Fila SPSC: 'fim' só é escrito pela ISR, 'ini' só pelo consumidor
+static botoes_evento_t fila[BOTOES_FILA];
+static volatile uint8_t fila_ini = 0;
+static volatile uint8_t fila_fim = 0;
+
+void botoes_init(uint8_t mascara) {
+    mascara_botoes = mascara & ((1 << BOTOES_MAX_PINOS) - 1);
+    
+    // Recomeça do zero (botoes_init pode ser chamada de novo)
+    ct0 = ct1 = 0xFF;
+    divisor = BOTOES_DIV_TICKS;
+    botoes_estado = 0;
+    longo_emitido = 0;
+    clique_pendente = 0;
+    fila_ini = fila_fim = 0;
+    mudou = 0;
+    
+    DDRC &= ~mascara_botoes;        // Entradas
+    PORTC |= mascara_botoes;        // Pull-up interno
+    PCMSK1 |= mascara_botoes;       // PCINT8-13 = PC0-PC5
+    PCIFR = (1 << PCIF1);
+    PCICR |= (1 << PCIE1);
+}
+
+void botoes_para() {
+    uint8_t sreg = SREG;
+    cli();
+    PCMSK1 &= ~mascara_botoes;
+    if (!PCMSK1) PCICR &= ~(1 << PCIE1);
+    mascara_botoes = 0;
+    botoes_estado = 0;
+    SREG = sreg;
+}
+
+// Só acorda a CPU; o debounce acontece no tick
+EMPTY_INTERRUPT(PCINT1_vect);
+
+static void empilha(uint8_t tipo, uint8_t botao, uint16_t t) {
+    uint8_t prox = (fila_fim + 1) & (BOTOES_FILA - 1);
+    if (prox == fila_ini) {
+        botoes_perdidos++;
+        return;
+    }
+    botoes_evento_t *ev = &fila[fila_fim];
+    ev->tipo = tipo;
+    ev->botao = botao;
+    ev->t = t;
+    BARREIRA();
+    fila_fim = prox;
+    mudou = 1;
+}
+
+static void classifica(uint8_t alterados, uint16_t agora) {
+    uint8_t estado = botoes_estado;
+    uint8_t bit = 1;
+    
+    for (uint8_t b = 0; b < BOTOES_MAX_PINOS; b++, bit <<= 1) {
+        if (alterados & bit) {
+            if (estado & bit) {
+                empilha(EVT_PRESS, b, agora);
+                t_pressao[b] = agora;
+                longo_emitido &= ~bit;
+            } else {
+                empilha(EVT_RELEASE, b, agora);
+                if (!(longo_emitido & bit) && (uint16_t)(agora - t_pressao[b]) <= botoes_clique_max_ms) {
+                    empilha(EVT_CLICK, b, agora);
+                    if ((clique_pendente & bit) && (uint16_t)(agora - t_clique[b]) <= botoes_duplo_ms) {
+                        empilha(EVT_DOUBLE_CLICK, b, agora);
+                        clique_pendente &= ~bit;
+                    } else {
+                        clique_pendente |= bit;
+                        t_clique[b] = agora;
+                    }
+                }
+            }
+        } else {
+            if ((estado & ~longo_emitido & bit) && (uint16_t)(agora - t_pressao[b]) >= botoes_longo_ms) {
+                empilha(EVT_LONG_PRESS, b, agora);
+                longo_emitido |= bit;
+            }
+            // Janela de duplo clique vencida: fecha já, antes que o tick16
+            // dê a volta e um clique 65536ms depois pareça o segundo
+            if ((clique_pendente & bit) && (uint16_t)(agora - t_clique[b]) > botoes_duplo_ms) {
+                clique_pendente &= ~bit;
+            }
+        }
+    }
+}
+
+void botoes_tick() {
+    if (--divisor) return;
+    divisor = BOTOES_DIV_TICKS;
+    TRACE_ISR(TRACE_BOTOES);
+    
+    uint8_t i = (botoes_estado ^ ~PINC) & mascara_botoes;  // Bits diferentes do estado
+    ct0 = ~(ct0 & i);                                     // Conta 4 amostras
+    ct1 = ct0 ^ (ct1 & i);                                // (zera onde i == 0)
+    i &= ct0 & ct1;                                       // Estouro → mudança aceita
+    botoes_estado ^= i;
+    
+    // Só percorre os pinos se algo mudou, há botão segurado sem LONG_PRESS
+    // ou janela de duplo clique aberta
+    if (i || (botoes_estado & ~longo_emitido) || clique_pendente) {
+        classifica(i, tick16_isr());
+    }
+}
+
+uint8_t botoes_evento(botoes_evento_t *ev) {
+    uint8_t ini = fila_ini;
+    if (ini == fila_fim) return 0;
+    BARREIRA();
+    *ev = fila[ini];
+    BARREIRA();
+    fila_ini = (ini + 1) & (BOTOES_FILA - 1);
+    return 1;
+}
+
+// Com interrupções desligadas. A janela de duplo clique aberta segura o
+// tick (é ele que a fecha): sem isso o tempo pararia no sono e o próximo
+// clique viraria DOUBLE_CLICK
+uint8_t botoes_ocioso() {
+    if (!mascara_botoes) return 1;
+    if (botoes_estado || mudou || fila_ini != fila_fim) return 0;
+    if ((uint8_t)~PINC & mascara_botoes) return 0;      // Pressão ainda no debounce
+    return !clique_pendente;
+}
+
+uint8_t botoes_mudou() {
+    if (!mudou) return 0;
+    mudou = 0;
+    return 1;
+}
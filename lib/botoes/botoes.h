@@ -0,0 +1,72 @@
+/*
+ * ================================================================================
+ * BOTOES - CAPTURA POR PCINT1 + DEBOUNCE POR CONTADOR VERTICAL (PORTC)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * - botoes_tick() roda dentro da ISR de 1ms (timebase_tick_hook) e amostra
+ *   PINC a cada BOTOES_DIV_TICKS ms. Um contador vertical de 2 bits por pino
+ *   debounça todos os bits da porta em paralelo: o estado só muda após
+ *   4 amostras iguais seguidas (4 × 4ms = 16ms)
+ * - Cada mudança vira um evento com timestamp (ms, 16 bits) numa fila
+ *   circular lock-free (produtor = ISR, consumidor = loop). O classificador,
+ *   também na ISR, gera os gestos:
+ *     EVT_PRESS / EVT_RELEASE   borda debounçada
+ *     EVT_CLICK                 soltou em até botoes_clique_max_ms
+ *     EVT_DOUBLE_CLICK          segundo CLICK em até botoes_duplo_ms (a
+ *                               janela vencida é fechada no tick)
+ *     EVT_LONG_PRESS            segurou por botoes_longo_ms (uma vez por pressão)
+ * - PCINT1 habilitada nos pinos dos botões: qualquer mudança acorda a CPU
+ * - botoes_ocioso(): todos soltos e estáveis, fila consumida e nenhuma
+ *   janela de duplo clique aberta: só uma borda (PCINT1) muda algo, dá
+ *   para dormir sem o tick de 1ms (chamar com interrupções desligadas)
+ * - botoes_para(): desliga a PCINT1 dos botões e para de amostrar (troca
+ *   de módulo no firmware único); os pinos ficam como estão
+ * - Convenção: bit = 1 → botão pressionado (pinos com pull-up, ativo em 0);
+ *   'botao' nos eventos = número do bit em PORTC (PC2 → 2)
+ * ================================================================================
+ */
+
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include <stdint.h>
+
+#ifndef BOTOES_DIV_TICKS
+#define BOTOES_DIV_TICKS    4
+#endif
+
+#ifndef BOTOES_FILA
+#define BOTOES_FILA         16      // Potência de 2
+#endif
+
+#define BOTOES_MAX_PINOS    6       // PC0-PC5
+
+#define EVT_PRESS           1
+#define EVT_RELEASE         2
+#define EVT_CLICK           3
+#define EVT_DOUBLE_CLICK    4
+#define EVT_LONG_PRESS      5
+
+typedef struct {
+    uint8_t tipo;
+    uint8_t botao;
+    uint16_t t;                     // tick16_isr() no momento do evento
+} botoes_evento_t;
+
+extern volatile uint8_t botoes_estado;   // Estado debounçado (bits de PORTC)
+extern volatile uint8_t botoes_perdidos; // Eventos descartados (fila cheia)
+
+// Limiares do classificador (alterar antes de botoes_init)
+extern uint16_t botoes_clique_max_ms;
+extern uint16_t botoes_duplo_ms;
+extern uint16_t botoes_longo_ms;
+
+void botoes_init(uint8_t mascara);
+void botoes_para();
+void botoes_tick();
+uint8_t botoes_evento(botoes_evento_t *ev);
+uint8_t botoes_mudou();
+uint8_t botoes_ocioso();
+
+#endif
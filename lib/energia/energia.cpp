@@ -0,0 +1,51 @@
+/*
+ * ================================================================================
+ * ENERGIA - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "energia.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#define CS_MASCARA  0x07            // CSn2:0 em TCCR1B/TCCR2B
+
+uint16_t energia_desligamentos = 0;
+
+static uint8_t desligados = 0;      // Bits de PRR postos por energia_desliga()
+
+void energia_desliga(uint8_t prr) {
+    if (prr & (1 << PRADC)) ADCSRA &= ~(1 << ADEN);
+    ACSR |= (1 << ACD);
+    desligados |= prr;
+    PRR |= prr;
+}
+
+void energia_religa() {
+    PRR &= ~desligados;
+    ACSR &= ~(1 << ACD);
+    desligados = 0;
+}
+
+void energia_power_down() {
+    uint8_t prr = PRR;
+    uint8_t tccr1b = TCCR1B;
+    uint8_t tccr2b = TCCR2B;
+    TCCR1B = tccr1b & ~CS_MASCARA;
+    TCCR2B = tccr2b & ~CS_MASCARA;
+    PRR = prr | (1 << PRTIM1) | (1 << PRTIM2);
+
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_bod_disable();            // Vale até o SLEEP (3 ciclos): nada no meio
+    sei();
+    sleep_cpu();
+    sleep_disable();
+
+    // Acordou (a ISR da borda já rodou): timers de volta de onde pararam
+    PRR = prr;
+    TCCR2B = tccr2b;
+    TCCR1B = tccr1b;
+    energia_desligamentos++;
+}
@@ -0,0 +1,39 @@
+/*
+ * ================================================================================
+ * ENERGIA - PERIFÉRICOS DESLIGADOS NO PRR E SONO EM POWER_DOWN
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * - energia_desliga(prr): desliga de vez o que o módulo não usa. Com PRADC
+ *   o ADC é desabilitado antes (ADEN = 0, exigência do datasheet); o
+ *   comparador analógico também é desligado (ACD). energia_religa() desfaz
+ * - energia_power_down(): chamada com interrupções desligadas (ex.: de
+ *   sched_ocioso_hook()), volta com elas ligadas depois da ISR que acordou
+ *   * Timer1 e Timer2 parados (CS = 0) e no PRR durante o sono: o ms da
+ *     base de tempo não anda, então ninguém pode estar esperando tempo
+ *     (LED piscando, deadline, debounce, fila da serial)
+ *   * BOD desligado durante o sono (BODS); só PCINT/INT0/INT1/WDT acordam.
+ *     A USART também para: o que chegar pela serial no sono se perde
+ *   * Partida: 16K CK (~1ms) com os fusíveis do Uno (cristal, SUT = 11)
+ *     antes da 1ª instrução; bench/simavr_bench soma isso à latência medida
+ * - energia_desligamentos conta as entradas em POWER_DOWN
+ * ================================================================================
+ */
+
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <stdint.h>
+#include <avr/io.h>
+
+// O que nenhum módulo usa: ADC, TWI, SPI e Timer0 (a base de tempo é o
+// Timer1; no core Arduino isso também cala a ISR de overflow do Timer0)
+#define ENERGIA_SEM_USO     ((1 << PRADC) | (1 << PRTWI) | (1 << PRSPI) | (1 << PRTIM0))
+
+extern uint16_t energia_desligamentos;
+
+void energia_desliga(uint8_t prr);
+void energia_religa();
+void energia_power_down();
+
+#endif
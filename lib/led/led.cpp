@@ -0,0 +1,250 @@
+/*
+ * ================================================================================
+ * LED - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "led.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "timer2.h"
+
+// COMnx1:0 em modo não-PWM
+#define COM_TROCA   1
+#define COM_ZERA    2
+#define COM_SETA    3
+
+// ================================================================================
+// PD3 / OC2B (Timer2)
+// ================================================================================
+#define OC2B_PARADO 0
+#define OC2B_CTC    1           // Frequência: troca no compare, sem ISR
+#define OC2B_LENTO  2           // Pisca: ISR programa cada compare
+
+static uint8_t oc2b_modo = OC2B_PARADO;
+static uint32_t t2_meio8;       // Meio período em 1/8 de contagem (8µs)
+static uint32_t t2_falta8;      // Do último compare até a próxima troca
+static uint8_t t2_nivel;        // Nível do pino depois do compare programado
+
+// Programa o próximo compare a partir do atual. Falta mais que um giro
+// do Timer2: compare "vazio" daqui a 256 contagens (OCR2B += 0), com o
+// modo igual ao nível atual; senão o da troca, e o resto fracionário
+// passa para o meio período seguinte
+static void oc2b_programa() {
+    uint32_t f = t2_falta8;
+    if ((f >> 3) > 256) {
+        t2_falta8 = f - 256 * 8;
+    } else {
+        OCR2B += (uint8_t)(f >> 3);
+        t2_falta8 = (f & 7) + t2_meio8;
+        t2_nivel ^= 1;
+    }
+    TCCR2A = (uint8_t)((t2_nivel ? COM_SETA : COM_ZERA) << COM2B0);    // Modo normal
+}
+
+static void oc2b_solta() {
+    if (oc2b_modo == OC2B_PARADO) return;
+    TIMSK2 &= ~(1 << OCIE2B);
+    TCCR2B = 0;
+    TCCR2A = 0;
+    TIFR2 = (1 << OCF2B);
+    oc2b_modo = OC2B_PARADO;
+}
+
+// Já piscando: só troca o meio período
+static void oc2b_lento(uint32_t meio8) {
+    t2_meio8 = meio8;
+    if (oc2b_modo == OC2B_LENTO) return;
+
+    oc2b_solta();
+    t2_nivel = 1;
+    t2_falta8 = meio8;
+    TCCR2A = (COM_SETA << COM2B0);
+    TCNT2 = 0;
+    OCR2B = 2;                                          // Acende logo adiante
+    TIFR2 = (1 << OCF2B);
+    timer2_compb(oc2b_programa);                        // ISR de compare B (lib/timer2)
+    TIMSK2 |= (1 << OCIE2B);
+    TCCR2B = (1 << CS22) | (1 << CS21) | (1 << CS20);   // Prescaler 1024
+    oc2b_modo = OC2B_LENTO;
+}
+
+// f = F_CPU / (2 * N * (TOP + 1)). O menor prescaler em que o TOP cabe
+// dá o maior TOP, ou seja, o menor erro
+static uint8_t oc2b_ctc(uint16_t hz) {
+    static const uint16_t DIV[7] = { 1, 8, 32, 64, 128, 256, 1024 };
+    for (uint8_t i = 0; i < 7; i++) {
+        uint32_t top1 = (F_CPU / 2 / DIV[i] + hz / 2) / hz;
+        if (top1 > 256) continue;
+
+        oc2b_solta();
+        TCNT2 = 0;
+        OCR2A = (uint8_t)(top1 - 1);
+        OCR2B = 0;
+        TCCR2A = (COM_TROCA << COM2B0) | (1 << WGM21);     // CTC, troca OC2B
+        TCCR2B = i + 1;
+        oc2b_modo = OC2B_CTC;
+        return 1;
+    }
+    return 0;
+}
+
+// ================================================================================
+// PB1 / OC1A (Timer1 da base de tempo) E PINOS SEM OC (ISR de 1ms)
+// ================================================================================
+static uint16_t oc1a_meio = 0;  // 0 = parado
+static uint16_t oc1a_falta;
+static uint8_t oc1a_nivel;
+
+typedef struct {
+    volatile uint8_t *porta;    // 0 = livre
+    uint8_t mascara;
+    uint16_t meio;              // ms entre trocas
+    uint16_t falta;
+} led_sw_t;
+
+static led_sw_t sw[LED_CANAIS_SW];
+
+static volatile uint8_t *porta(uint8_t pino) {
+    switch (pino & 0x18) {
+        case LED_PORTB: return &PORTB;
+        case LED_PORTC: return &PORTC;
+        default: return &PORTD;
+    }
+}
+
+// Canal do pino ou, se ele não pisca, um livre (0 se acabaram)
+static led_sw_t *canal(volatile uint8_t *p, uint8_t mascara, uint8_t livre) {
+    led_sw_t *vazio = 0;
+    for (uint8_t i = 0; i < LED_CANAIS_SW; i++) {
+        if (sw[i].porta == p && sw[i].mascara == mascara) return &sw[i];
+        if (!sw[i].porta && !vazio) vazio = &sw[i];
+    }
+    return livre ? vazio : 0;
+}
+
+// Dentro da ISR de 1ms, logo depois do compare de OC1A
+void led_tick() {
+    if (oc1a_meio) {
+        if (--oc1a_falta == 0) {
+            oc1a_falta = oc1a_meio;
+            oc1a_nivel ^= 1;
+        }
+        TCCR1A = (TCCR1A & ~(3 << COM1A0)) | ((oc1a_nivel ? COM_SETA : COM_ZERA) << COM1A0);
+    }
+    for (uint8_t i = 0; i < LED_CANAIS_SW; i++) {
+        led_sw_t *c = &sw[i];
+        if (c->porta && --c->falta == 0) {
+            c->falta = c->meio;
+            *c->porta ^= c->mascara;
+        }
+    }
+}
+
+// ================================================================================
+// API
+// ================================================================================
+void led_blink(uint8_t pino, uint16_t periodo_ms) {
+    if (!periodo_ms) {
+        led_fixo(pino, 0);
+        return;
+    }
+
+    uint8_t sreg = SREG;
+    cli();
+    if (pino == LED_PINO_OC2B) {
+        oc2b_lento((uint32_t)periodo_ms * 125 / 2);     // 1ms = 125/8 contagens
+    } else {
+        uint16_t meio = periodo_ms / 2;
+        if (!meio) meio = 1;
+        if (pino == LED_PINO_OC1A) {
+            if (!oc1a_meio) {
+                oc1a_nivel = 1;
+                oc1a_falta = meio;
+                TCCR1A = (TCCR1A & ~(3 << COM1A0)) | (COM_SETA << COM1A0);
+            } else if (oc1a_falta > meio) {
+                oc1a_falta = meio;
+            }
+            oc1a_meio = meio;
+        } else {
+            volatile uint8_t *p = porta(pino);
+            uint8_t mascara = 1 << (pino & 7);
+            led_sw_t *c = canal(p, mascara, 1);
+            if (c && !c->porta) {
+                *p |= mascara;
+                c->porta = p;
+                c->mascara = mascara;
+                c->falta = meio;
+            } else if (c && c->falta > meio) {
+                c->falta = meio;
+            }
+            if (c) c->meio = meio;
+        }
+    }
+    SREG = sreg;
+}
+
+// Só o PD3 passa de 500Hz; nos outros pinos o período é arredondado para
+// ms (mínimo 2ms: acima de 500Hz fica em 500Hz, não apaga)
+void led_set_frequency(uint8_t pino, uint16_t hz) {
+    if (!hz) {
+        led_fixo(pino, 0);
+        return;
+    }
+    if (pino != LED_PINO_OC2B) {
+        uint16_t p = (uint16_t)((1000UL + hz / 2) / hz);
+        if (p < 2) p = 2;
+        led_blink(pino, p);
+        return;
+    }
+
+    uint8_t sreg = SREG;
+    cli();
+    if (!oc2b_ctc(hz)) oc2b_lento(62500UL / hz);        // < 31Hz
+    SREG = sreg;
+}
+
+// Para o pisca do pino, devolve o pino ao PORTx e deixa 'nivel'
+void led_fixo(uint8_t pino, uint8_t nivel) {
+    volatile uint8_t *p = porta(pino);
+    uint8_t mascara = 1 << (pino & 7);
+
+    uint8_t sreg = SREG;
+    cli();
+    if (pino == LED_PINO_OC2B) {
+        oc2b_solta();
+    } else if (pino == LED_PINO_OC1A) {
+        oc1a_meio = 0;
+        TCCR1A &= ~(3 << COM1A0);
+    } else {
+        led_sw_t *c = canal(p, mascara, 0);
+        if (c) c->porta = 0;
+    }
+    if (nivel) *p |= mascara;
+    else *p &= ~mascara;
+    SREG = sreg;
+}
+
+// Algum pino piscando (com timer ou na ISR de 1ms)
+uint8_t led_ativo() {
+    if (oc2b_modo != OC2B_PARADO || oc1a_meio) return 1;
+    for (uint8_t i = 0; i < LED_CANAIS_SW; i++) {
+        if (sw[i].porta) return 1;
+    }
+    return 0;
+}
+
+// Para todos os piscas e apaga os pinos deles
+void led_para() {
+    if (oc2b_modo != OC2B_PARADO) led_fixo(LED_PINO_OC2B, 0);
+    if (oc1a_meio) led_fixo(LED_PINO_OC1A, 0);
+    for (uint8_t i = 0; i < LED_CANAIS_SW; i++) {
+        volatile uint8_t *p = sw[i].porta;
+        if (!p) continue;
+        uint8_t sreg = SREG;
+        cli();
+        sw[i].porta = 0;
+        *p &= ~sw[i].mascara;
+        SREG = sreg;
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * ================================================================================
+ * LED - PISCA-PISCA E FREQUÊNCIA PELO HARDWARE DOS TIMERS
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * O pino troca sozinho, sem tarefa no loop nem TGL_BIT por software:
+ * - PD3 (OC2B): Timer2 com saída de compare. A borda sai no compare, com
+ *   precisão de uma contagem, qualquer que seja a carga do loop
+ *   * led_set_frequency() >= 31Hz: CTC com "troca OC2B no compare", sem
+ *     interrupção nenhuma (até 8MHz, prescaler/TOP escolhidos pelo menor erro)
+ *   * Períodos longos (led_blink, < 31Hz): modo normal, prescaler 1024
+ *     (64µs). A ISR de compare B só programa o próximo compare (no máximo
+ *     um a cada 16,4ms) e o modo "seta"/"zera" do OC2B para ele; resto de
+ *     1/8 de contagem acumulado, sem deriva. 31ms (Ex 3.5) = ~2 ISRs por borda
+ * - PB1 (OC1A): o Timer1 é a base de tempo (CTC em 1ms), então o período é
+ *   múltiplo de 1ms. led_tick() escolhe "seta"/"zera" para o compare
+ *   seguinte: a borda é do hardware, exatamente no ms
+ * - Outros pinos: led_tick() troca o bit de PORTx na ISR de 1ms (até
+ *   LED_CANAIS_SW pinos). Resolução de 1ms, atraso só o de entrada na ISR
+ *
+ * led_tick() deve ser chamada dentro de timebase_tick_hook(). Com o OC
+ * conectado, escritas em PORTx não chegam ao pino: led_fixo() desconecta e
+ * deixa o nível pedido. O Timer2 fica por conta deste serviço enquanto o
+ * PD3 pisca (um de cada vez com lib/bam e a multiplexação do Módulo 2); a
+ * ISR de compare B é de lib/timer2, que chama o tratador registrado.
+ * ================================================================================
+ */
+
+#ifndef LED_H
+#define LED_H
+
+#include <stdint.h>
+
+#define LED_PORTB       0x00
+#define LED_PORTC       0x08
+#define LED_PORTD       0x10
+#define LED_PINO(porta, bit)    ((uint8_t)((porta) | (bit)))
+
+#define LED_PINO_OC2B   LED_PINO(LED_PORTD, 3)
+#define LED_PINO_OC1A   LED_PINO(LED_PORTB, 1)
+
+#define LED_CANAIS_SW   4
+
+// periodo_ms = aceso + apagado. Pino parado: acende já e troca a cada meio
+// período. Pino já piscando: só o período muda (vale a partir da próxima
+// troca, sem reiniciar a fase). 0 = led_fixo(pino, 0)
+void led_blink(uint8_t pino, uint16_t periodo_ms);
+void led_set_frequency(uint8_t pino, uint16_t hz);
+void led_fixo(uint8_t pino, uint8_t nivel);
+void led_para();
+uint8_t led_ativo();            // 1 = algum pino piscando (precisa dos timers)
+void led_tick();
+
+#endif
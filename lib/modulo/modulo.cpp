@@ -0,0 +1,61 @@
+/*
+ * ================================================================================
+ * MODULO - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "modulo.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "scheduler.h"
+#include "telemetria.h"
+
+modulo_t modulo_atual = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+// Entrada sem pull-up: nada fica acionado entre um módulo e outro
+void modulo_solta_pinos(const modulo_pinos_t *p) {
+    uint8_t sreg = SREG;
+    cli();
+    PORTB &= ~p->b;
+    DDRB &= ~p->b;
+    PORTC &= ~p->c;
+    DDRC &= ~p->c;
+    PORTD &= ~p->d;
+    DDRD &= ~p->d;
+    SREG = sreg;
+}
+
+// desc aponta para um descritor em PROGMEM
+void modulo_troca(const modulo_t *desc, uint8_t ex) {
+    modulo_t novo;
+    memcpy_P(&novo, desc, sizeof(novo));
+
+    // A ISR de 1ms para de chamar o módulo antigo antes de ele encerrar
+    uint8_t sreg = SREG;
+    cli();
+    modulo_atual.tick = 0;
+    SREG = sreg;
+
+    if (modulo_atual.encerra) modulo_atual.encerra();
+    sched_limpa();
+    telemetria_reinicia();      // Contadores do escalonador voltaram a 0
+    modulo_solta_pinos(&modulo_atual.pinos);
+
+    sreg = SREG;
+    cli();
+    modulo_atual = novo;
+    modulo_atual.tick = 0;
+    SREG = sreg;
+
+    modulo_atual.inicia(ex);
+
+    sreg = SREG;
+    cli();
+    modulo_atual.tick = novo.tick;
+    SREG = sreg;
+}
+
+void modulo_tick() {
+    if (modulo_atual.tick) modulo_atual.tick();
+}
@@ -0,0 +1,60 @@
+/*
+ * ================================================================================
+ * MODULO - REGISTRO DOS MÓDULOS E POSSE DOS PINOS
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * - Cada arquivo de modulos/ exporta um modulo_t (em PROGMEM) com
+ *   inicia/passo/encerra/tick e os pinos que usa em PORTB/C/D
+ * - Build separado: setup()/loop() do próprio módulo chamam essas funções.
+ *   Firmware único (-DFIRMWARE_UNICO): os três módulos entram na mesma
+ *   imagem e modulo_troca() passa de um para outro em tempo de execução
+ * - modulo_troca(): encerra o módulo atual (ISRs/timers dele), limpa o
+ *   escalonador (e as bases dos deltas da telemetria), solta os pinos do módulo (entrada, sem pull-up) e só
+ *   então inicia o próximo - os módulos disputam PORTB e PORTC
+ * - Serial (PD0/PD1) e Timer1 (timebase) são do firmware, não dos módulos
+ * ================================================================================
+ */
+
+#ifndef MODULO_H
+#define MODULO_H
+
+#include <stdint.h>
+
+// ================================================================================
+// MACROS PARA MANIPULAÇÃO DE BITS (compartilhadas pelos módulos)
+// ================================================================================
+// O Módulo 3 usa Pin/PinGroup (lib/pino), que levam a porta no tipo
+#define SET_BIT(REG, BIT)    (REG |= (1 << BIT))
+#define CLR_BIT(REG, BIT)    (REG &= ~(1 << BIT))
+#define TGL_BIT(REG, BIT)    (REG ^= (1 << BIT))
+#define READ_BIT(REG, BIT)   ((REG >> BIT) & 1)
+
+typedef struct {
+    uint8_t b;
+    uint8_t c;
+    uint8_t d;
+} modulo_pinos_t;
+
+typedef struct {
+    void (*inicia)(uint8_t ex);     // Configura pinos/periféricos e arma o exercício
+    void (*passo)();                // Corpo do loop()
+    void (*encerra)();              // Desliga ISRs/timers próprios
+    void (*tick)();                 // Chamado na ISR de 1ms (0 = nenhum)
+    uint8_t primeiro;               // Número do 1º exercício (numeração do módulo)
+    uint8_t n;                      // Quantidade de exercícios
+    modulo_pinos_t pinos;           // Pinos usados (soltos na troca)
+} modulo_t;
+
+// Descritores (um por arquivo em modulos/)
+extern const modulo_t MODULO1;
+extern const modulo_t MODULO2;
+extern const modulo_t MODULO3;
+
+extern modulo_t modulo_atual;       // Cópia em RAM do descritor ativo
+
+void modulo_troca(const modulo_t *desc, uint8_t ex);
+void modulo_solta_pinos(const modulo_pinos_t *p);
+void modulo_tick();
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * ================================================================================
+ * PINO - DESCRITORES DE PINO EM TEMPO DE COMPILAÇÃO (Pin / PinGroup)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * Substitui "#define LED3 PB0" + SET_BIT(PORTx, LED3): o pino carrega a
+ * porta no tipo, então não há como escrever o bit de PB0 em PORTD.
+ * - Pin<Porta, Bit>: tudo inline e com endereço constante. Em PortB/C/D,
+ *   set()/clr() viram sbi/cbi e read() vira sbis/sbic (ou in + andi);
+ *   mesma quantidade de código do SET_BIT equivalente, só que tipado
+ * - Sombra<Porta>: mesma porta, mas as escritas vão para a cópia de
+ *   lib/sombra (os pinos mudam no sombra_commit()); DDR e PIN são os reais
+ * - PinGroup<Pinos...>: máscaras por porta calculadas pelo compilador.
+ *   set()/clr()/write(v)/output() fazem 1 escrita (mascarada) por porta
+ *   presente no grupo, não uma por pino. write(v): bit i de v vai para o
+ *   i-ésimo pino da lista. Quem escreve é o tipo do primeiro pino de cada
+ *   porta: num grupo que escreve, não misture PortD e Sombra<PortD>
+ * - Conflitos: dois pinos do grupo no mesmo bit da mesma porta são erro de
+ *   compilação (static_assert), assim como Bit >= 8
+ * - Pin::id segue a numeração de LED_PINO/SOMBRA_PINO (porta << 3 | bit)
+ * - Só cabeçalho, C++11 (avr-gcc gnu++11): nada de if constexpr nem
+ *   fold expressions; as máscaras saem de funções constexpr recursivas
+ * ================================================================================
+ */
+
+#ifndef PINO_H
+#define PINO_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "sombra.h"
+
+// ================================================================================
+// PORTAS
+// ================================================================================
+// id = índice de lib/sombra (SOMBRA_B/C/D)
+#define PINO_PORTA(Nome, n, PORTx, DDRx, PINx)                              \
+struct Nome {                                                               \
+    typedef volatile uint8_t reg_t;                                         \
+    static const uint8_t id = n;                                            \
+    static inline reg_t &out() { return PORTx; }                            \
+    static inline volatile uint8_t &dir() { return DDRx; }                  \
+    static inline volatile uint8_t &in() { return PINx; }                   \
+};
+
+PINO_PORTA(PortB, SOMBRA_B, PORTB, DDRB, PINB)
+PINO_PORTA(PortC, SOMBRA_C, PORTC, DDRC, PINC)
+PINO_PORTA(PortD, SOMBRA_D, PORTD, DDRD, PIND)
+
+// Escritas na cópia em RAM (lds/ori/sts); o commit leva aos pinos
+template <class P>
+struct Sombra {
+    typedef uint8_t reg_t;
+    static const uint8_t id = P::id;
+    static inline reg_t &out() { return sombra[P::id]; }
+    static inline volatile uint8_t &dir() { return P::dir(); }
+    static inline volatile uint8_t &in() { return P::in(); }
+};
+
+// ================================================================================
+// PINO ÚNICO
+// ================================================================================
+template <class P, uint8_t B>
+struct Pin {
+    static_assert(B < 8, "Pin: bit fora da porta (0-7)");
+
+    typedef P Porta;
+    static const uint8_t bit = B;
+    static const uint8_t mascara = (uint8_t)(1 << B);
+    static const uint8_t id = (uint8_t)((P::id << 3) | B);
+
+    static inline void set()            { P::out() |= mascara; }
+    static inline void clr()            { P::out() &= (uint8_t)~mascara; }
+    static inline void tgl()            { P::out() ^= mascara; }
+    static inline void write(uint8_t v) { if (v) set(); else clr(); }
+    static inline uint8_t read()        { return (P::in() & mascara) ? 1 : 0; }
+    static inline void output()         { P::dir() |= mascara; }
+    static inline void input()          { P::dir() &= (uint8_t)~mascara; }
+};
+
+// ================================================================================
+// GRUPO DE PINOS
+// ================================================================================
+namespace pino_detalhe {
+
+// OR das máscaras dos pinos do grupo que estão na porta 'id'
+template <uint8_t id>
+constexpr uint8_t mascara() { return 0; }
+
+template <uint8_t id, class X, class... Xs>
+constexpr uint8_t mascara() {
+    return (uint8_t)((X::Porta::id == id ? X::mascara : 0) | mascara<id, Xs...>());
+}
+
+// Soma das máscaras: difere do OR se dois pinos dividem um bit
+template <uint8_t id>
+constexpr uint16_t soma() { return 0; }
+
+template <uint8_t id, class X, class... Xs>
+constexpr uint16_t soma() {
+    return (uint16_t)((X::Porta::id == id ? X::mascara : 0) + soma<id, Xs...>());
+}
+
+// Bit i de v → posição do i-ésimo pino, só para os pinos da porta 'id'
+template <uint8_t id, uint8_t i>
+constexpr uint8_t espalha(uint8_t) { return 0; }
+
+template <uint8_t id, uint8_t i, class X, class... Xs>
+constexpr uint8_t espalha(uint8_t v) {
+    return (uint8_t)((X::Porta::id == id ? ((v >> i) & 1) << X::bit : 0) |
+                     espalha<id, i + 1, Xs...>(v));
+}
+
+// Percorre a lista uma vez por porta: o primeiro pino de cada porta ainda
+// não vista ('vistas', bit = id) escreve a máscara inteira dela
+template <class G, uint8_t vistas, class... Xs>
+struct PorPorta {
+    static inline void set() {}
+    static inline void clr() {}
+    static inline void write(uint8_t) {}
+    static inline void output() {}
+};
+
+template <class G, uint8_t vistas, class X, class... Xs>
+struct PorPorta<G, vistas, X, Xs...> {
+    typedef typename X::Porta P;
+    static const uint8_t nova = !(vistas & (1 << P::id));
+    typedef PorPorta<G, (uint8_t)(vistas | (1 << P::id)), Xs...> Resto;
+
+    static inline void set() {
+        if (nova) P::out() |= G::template mascara<P>();
+        Resto::set();
+    }
+    static inline void clr() {
+        if (nova) P::out() &= (uint8_t)~G::template mascara<P>();
+        Resto::clr();
+    }
+    static inline void write(uint8_t v) {
+        if (nova) {
+            P::out() = (uint8_t)((P::out() & (uint8_t)~G::template mascara<P>()) |
+                                 G::template espalha<P>(v));
+        }
+        Resto::write(v);
+    }
+    static inline void output() {
+        if (nova) P::dir() |= G::template mascara<P>();
+        Resto::output();
+    }
+};
+
+} // namespace pino_detalhe
+
+template <class... Xs>
+struct PinGroup {
+    typedef PinGroup<Xs...> Eu;
+    static const uint8_t n = sizeof...(Xs);
+
+    // Máscara do grupo em uma porta (PortB, Sombra<PortD>, ...)
+    template <class P>
+    static constexpr uint8_t mascara() { return pino_detalhe::mascara<P::id, Xs...>(); }
+
+    // Valor de write(v) nos bits da porta P (serve em tabelas constexpr)
+    template <class P>
+    static constexpr uint8_t espalha(uint8_t v) { return pino_detalhe::espalha<P::id, 0, Xs...>(v); }
+
+    static_assert(pino_detalhe::soma<SOMBRA_B, Xs...>() == pino_detalhe::mascara<SOMBRA_B, Xs...>() &&
+                  pino_detalhe::soma<SOMBRA_C, Xs...>() == pino_detalhe::mascara<SOMBRA_C, Xs...>() &&
+                  pino_detalhe::soma<SOMBRA_D, Xs...>() == pino_detalhe::mascara<SOMBRA_D, Xs...>(),
+                  "PinGroup: dois pinos no mesmo bit da mesma porta");
+
+    static inline void set()            { pino_detalhe::PorPorta<Eu, 0, Xs...>::set(); }
+    static inline void clr()            { pino_detalhe::PorPorta<Eu, 0, Xs...>::clr(); }
+    static inline void write(uint8_t v) { pino_detalhe::PorPorta<Eu, 0, Xs...>::write(v); }
+    static inline void output()         { pino_detalhe::PorPorta<Eu, 0, Xs...>::output(); }
+};
+
+#endif
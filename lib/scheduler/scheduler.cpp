@@ -0,0 +1,280 @@
+/*
+ * ================================================================================
+ * SCHEDULER - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "scheduler.h"
+#include "timebase.h"
+#include "trace.h"
+#include <avr/sleep.h>
+
+#define SCHED_RODANDO   0xFE
+
+static_assert(SCHED_MAX_TAREFAS <= 16, "sched_fundo usa uma máscara de 16 bits");
+
+sched_tarefa_t sched_tarefas[SCHED_MAX_TAREFAS];
+unsigned long sched_dormidas = 0;
+unsigned long sched_desligadas = 0;
+unsigned long sched_execucoes = 0;
+unsigned long sched_perdidos = 0;
+unsigned long sched_deriva = 0;
+
+static uint8_t heap[SCHED_MAX_TAREFAS];
+static uint8_t heap_n = 0;
+static uint8_t num_tarefas = 0;
+static uint16_t fundo = 0;      // Bit id: deadline não segura o sono profundo
+
+static uint8_t tarefa_atual = SCHED_NENHUMA;
+static uint8_t tem_proximo = 0;
+static tick16_t proximo = 0;
+
+// ================================================================================
+// MIN-HEAP POR DEADLINE
+// ================================================================================
+static inline uint8_t antes(uint8_t a, uint8_t b) {
+    return tick16_dif(sched_tarefas[a].deadline, sched_tarefas[b].deadline) < 0;
+}
+
+static void heap_troca(uint8_t i, uint8_t j) {
+    uint8_t tmp = heap[i];
+    heap[i] = heap[j];
+    heap[j] = tmp;
+    sched_tarefas[heap[i]].pos = i;
+    sched_tarefas[heap[j]].pos = j;
+}
+
+static void heap_sobe(uint8_t i) {
+    while (i > 0) {
+        uint8_t pai = (i - 1) / 2;
+        if (!antes(heap[i], heap[pai])) break;
+        heap_troca(i, pai);
+        i = pai;
+    }
+}
+
+static void heap_desce(uint8_t i) {
+    while (1) {
+        uint8_t menor = i;
+        uint8_t esq = 2 * i + 1;
+        uint8_t dir = esq + 1;
+        if (esq < heap_n && antes(heap[esq], heap[menor])) menor = esq;
+        if (dir < heap_n && antes(heap[dir], heap[menor])) menor = dir;
+        if (menor == i) break;
+        heap_troca(i, menor);
+        i = menor;
+    }
+}
+
+static void heap_insere(uint8_t id) {
+    heap[heap_n] = id;
+    sched_tarefas[id].pos = heap_n;
+    heap_n++;
+    heap_sobe(heap_n - 1);
+}
+
+static void heap_remove(uint8_t i) {
+    uint8_t id = heap[i];
+    heap_n--;
+    if (i != heap_n) {
+        heap[i] = heap[heap_n];
+        sched_tarefas[heap[i]].pos = i;
+        heap_sobe(i);
+        heap_desce(sched_tarefas[heap[i]].pos);
+    }
+    sched_tarefas[id].pos = SCHED_NENHUMA;
+}
+
+// ================================================================================
+// API
+// ================================================================================
+uint8_t sched_add(sched_fn_t fn) {
+    if (num_tarefas >= SCHED_MAX_TAREFAS) return SCHED_NENHUMA;
+    uint8_t id = num_tarefas++;
+    sched_tarefas[id].fn = fn;
+    sched_tarefas[id].pos = SCHED_NENHUMA;
+    fundo &= ~(1u << id);
+    return id;
+}
+
+void sched_fundo(uint8_t id) {
+    fundo |= (1u << id);
+}
+
+// Remove todas as tarefas (permite chamar o setup() de um módulo de novo)
+void sched_limpa() {
+    num_tarefas = 0;
+    heap_n = 0;
+    fundo = 0;
+    tarefa_atual = SCHED_NENHUMA;
+    tem_proximo = 0;
+    sched_dormidas = 0;
+    sched_desligadas = 0;
+    sched_execucoes = 0;
+    sched_perdidos = 0;
+    sched_deriva = 0;
+}
+
+void sched_at(uint8_t id, tick16_t deadline) {
+    sched_tarefa_t *t = &sched_tarefas[id];
+    if (t->pos == SCHED_RODANDO) {
+        // Tarefa em execução: vira o próximo deadline dela
+        if (!tem_proximo || tick16_dif(deadline, proximo) < 0) proximo = deadline;
+        tem_proximo = 1;
+        return;
+    }
+    if (t->pos != SCHED_NENHUMA) heap_remove(t->pos);
+    t->deadline = deadline;
+    heap_insere(id);
+}
+
+// Acorda a tarefa já (não adia se ela já estiver armada para antes)
+void sched_agora(uint8_t id) {
+    sched_tarefa_t *t = &sched_tarefas[id];
+    tick16_t agora = tick16();
+    if (t->pos < SCHED_RODANDO && tick16_venceu(agora, t->deadline)) return;
+    sched_at(id, agora);
+}
+
+void sched_stop(uint8_t id) {
+    sched_tarefa_t *t = &sched_tarefas[id];
+    if (t->pos == SCHED_RODANDO) {
+        tem_proximo = 0;
+    } else if (t->pos != SCHED_NENHUMA) {
+        heap_remove(t->pos);
+    }
+}
+
+void sched_next_at(tick16_t deadline) {
+    if (tarefa_atual != SCHED_NENHUMA) sched_at(tarefa_atual, deadline);
+}
+
+void sched_next(uint16_t ms) {
+    sched_next_at(tick16() + ms);
+}
+
+uint8_t sched_atual() {
+    return tarefa_atual;
+}
+
+void sched_reset_stats() {
+    for (uint8_t i = 0; i < num_tarefas; i++) {
+        sched_tarefas[i].wakeups = 0;
+        sched_tarefas[i].atraso_max = 0;
+        sched_tarefas[i].atraso_total = 0;
+        sched_tarefas[i].exec_us = 0;
+        sched_tarefas[i].perdidos = 0;
+        sched_tarefas[i].deriva = 0;
+    }
+    sched_dormidas = 0;
+    sched_desligadas = 0;
+    sched_execucoes = 0;
+    sched_perdidos = 0;
+    sched_deriva = 0;
+}
+
+// Só tarefas de fundo armadas (ou nenhuma)
+static uint8_t so_fundo() {
+    for (uint8_t i = 0; i < heap_n; i++) {
+        if (!(fundo & (1u << heap[i]))) return 0;
+    }
+    return 1;
+}
+
+void sched_run() {
+    if (heap_n) {
+        uint8_t id = heap[0];
+        sched_tarefa_t *t = &sched_tarefas[id];
+        int16_t atraso = tick16_dif(tick16(), t->deadline);
+        
+        if (atraso >= 0) {
+            heap_remove(0);
+            t->pos = SCHED_RODANDO;
+            t->wakeups++;
+            sched_execucoes++;
+            t->atraso_total += atraso;
+            if ((uint16_t)atraso > t->atraso_max) t->atraso_max = atraso;
+            
+            tarefa_atual = id;
+            tem_proximo = 0;
+            unsigned long inicio = micros_custom();
+            TRACE(TRACE_TAREFA_ENTRA + id);
+            t->fn();
+            TRACE(TRACE_TAREFA_SAI + id);
+            t->exec_us += micros_custom() - inicio;
+            tarefa_atual = SCHED_NENHUMA;
+            
+            t->pos = SCHED_NENHUMA;
+            if (tem_proximo) {
+                t->deadline = proximo;
+                heap_insere(id);
+            }
+            return;
+        }
+    }
+    
+    // Nada vencido: dorme até a próxima interrupção.
+    // sei() seguido de sleep_cpu() é atômico (a instrução após sei sempre executa).
+    // Sem deadline que importe, a aplicação pode dormir mais fundo (o hook
+    // decide e dorme com as interrupções desligadas até o sleep)
+    cli();
+    if (sched_ocioso_hook && so_fundo() && sched_ocioso_hook()) {
+        sched_dormidas++;
+        sched_desligadas++;
+        return;
+    }
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    sched_dormidas++;
+}
+
+// ================================================================================
+// TEMPORIZADOR PERIÓDICO
+// ================================================================================
+void sched_per_inicia(sched_per_t *p, uint16_t periodo, uint8_t politica) {
+    p->periodo = periodo;
+    p->politica = politica;
+    p->proximo = tick16() + periodo;
+}
+
+// Próximo deadline = anterior + periodo. Se ele também já passou, o
+// disparo atual perdeu 'n' períodos inteiros: aplica a política.
+// Deadline igual a agora não é perdido, só vence já (disparo exatamente
+// um período atrasado não conta perda nem deriva)
+void sched_per_avanca(sched_per_t *p) {
+    tick16_t agora = tick16();
+    p->proximo += p->periodo;
+    int16_t atraso = tick16_dif(agora, p->proximo);
+    if (atraso <= 0 || p->periodo == 0) return;
+
+    // SCHED_RAJADA: deadline fica no passado, as próximas chamadas disparam
+    // já e nenhum período se perde
+    if (p->politica == SCHED_RAJADA) return;
+
+    // Perdidos = deadlines antes de agora; o que cai em agora fica
+    uint16_t n = (uint16_t)(atraso - 1) / p->periodo + 1;
+    uint16_t deriva = 0;
+    if (p->politica == SCHED_PULA) {
+        p->proximo += n * p->periodo;
+    } else {
+        deriva = (uint16_t)atraso + p->periodo;     // Atraso do disparo atual
+        p->proximo = agora + p->periodo;
+    }
+
+    sched_perdidos += n;
+    sched_deriva += deriva;
+    if (tarefa_atual != SCHED_NENHUMA) {
+        sched_tarefa_t *t = &sched_tarefas[tarefa_atual];
+        t->perdidos += n;
+        t->deriva = (t->deriva > 0xFFFF - deriva) ? 0xFFFF : t->deriva + deriva;
+    }
+}
+
+uint8_t sched_per_venceu(sched_per_t *p) {
+    if (!sched_per_vencido(p)) return 0;
+    sched_per_avanca(p);
+    return 1;
+}
@@ -0,0 +1,97 @@
+/*
+ * ================================================================================
+ * SCHEDULER - ESCALONADOR COOPERATIVO ORDENADO POR DEADLINE
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * - Cada tarefa é uma função void(); as tarefas armadas ficam num min-heap
+ *   ordenado pelo deadline (tick16_t: 16 bits baixos do ms, comparação
+ *   segura no wrap; deadlines até 32767 ms à frente)
+ * - sched_run() executa a tarefa vencida mais antiga; se nenhuma venceu,
+ *   entra em SLEEP_MODE_IDLE até a próxima interrupção (tick de 1ms, etc.)
+ * - Dentro da tarefa, sched_next()/sched_next_at() registram o próximo
+ *   deadline; se chamadas mais de uma vez, vale o mais cedo. Tarefa que não
+ *   registra deadline fica dormente até sched_agora()/sched_at()
+ * - sched_fundo(id): o deadline da tarefa (ex.: telemetria) não impede o
+ *   sono profundo. Sem nada vencido e só tarefas de fundo armadas,
+ *   sched_run() chama sched_ocioso_hook() (opcional, símbolo weak) com as
+ *   interrupções desligadas: se ele dormiu (ex.: POWER_DOWN, lib/energia)
+ *   devolve 1 e volta com elas ligadas; 0 = dorme em IDLE como sempre
+ * - Estatísticas por tarefa: wakeups, atraso (lateness) e tempo de CPU
+ * - sched_per_t: temporizador periódico sem deriva (proximo += periodo, nunca
+ *   "agora + periodo"). Atraso de até um período não muda a fase (o
+ *   deadline seguinte igual a agora vence já); se um deadline inteiro
+ *   ficou no passado vale a política: SCHED_PULA descarta os
+ *   perdidos, SCHED_RAJADA dispara seguido até alcançar, SCHED_RESSINC
+ *   recomeça de agora (e o atraso vira deriva). Perdas e deriva entram nas
+ *   estatísticas da tarefa em execução (uma por exercício)
+ * ================================================================================
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include "timebase.h"
+
+#ifndef SCHED_MAX_TAREFAS
+#define SCHED_MAX_TAREFAS   12
+#endif
+
+#define SCHED_NENHUMA       0xFF
+
+typedef void (*sched_fn_t)();
+
+typedef struct {
+    sched_fn_t fn;
+    tick16_t deadline;            // Próximo deadline (ms)
+    uint16_t wakeups;             // Quantas vezes a tarefa rodou
+    uint16_t atraso_max;          // Maior atraso observado (ms, < 32768)
+    unsigned long atraso_total;   // Soma dos atrasos (ms)
+    unsigned long exec_us;        // Tempo total de CPU dentro da tarefa (µs)
+    uint16_t perdidos;            // Períodos descartados (SCHED_PULA/RESSINC)
+    uint16_t deriva;              // Fase perdida em SCHED_RESSINC (ms, satura em 65535)
+    uint8_t pos;                  // Posição no heap (SCHED_NENHUMA = dormente)
+} sched_tarefa_t;
+
+extern sched_tarefa_t sched_tarefas[SCHED_MAX_TAREFAS];
+extern unsigned long sched_dormidas;  // Entradas em sleep (IDLE ou pelo hook)
+extern unsigned long sched_desligadas; // Delas, pelo sched_ocioso_hook()
+extern unsigned long sched_execucoes; // Tarefas executadas (todas)
+extern unsigned long sched_perdidos;  // Períodos descartados (todas)
+extern unsigned long sched_deriva;    // Deriva acumulada (ms, todas)
+
+// Políticas para período perdido
+#define SCHED_PULA          0       // Pula para o próximo múltiplo (mantém a fase)
+#define SCHED_RAJADA        1       // Dispara sem esperar até alcançar (mantém a fase)
+#define SCHED_RESSINC       2       // Próximo = agora + periodo (fase perdida = deriva)
+
+typedef struct {
+    tick16_t proximo;             // Deadline nominal
+    uint16_t periodo;             // ms (< 32768)
+    uint8_t politica;
+} sched_per_t;
+
+uint8_t sched_add(sched_fn_t fn);
+void sched_fundo(uint8_t id);
+uint8_t sched_ocioso_hook() __attribute__((weak));
+void sched_limpa();
+void sched_at(uint8_t id, tick16_t deadline);
+void sched_agora(uint8_t id);
+void sched_stop(uint8_t id);
+void sched_next_at(tick16_t deadline);
+void sched_next(uint16_t ms);
+uint8_t sched_atual();
+void sched_reset_stats();
+void sched_run();
+
+void sched_per_inicia(sched_per_t *p, uint16_t periodo, uint8_t politica);
+void sched_per_avanca(sched_per_t *p);
+uint8_t sched_per_venceu(sched_per_t *p);
+
+// Só consulta (quem muda o período a cada disparo chama sched_per_avanca())
+static inline uint8_t sched_per_vencido(const sched_per_t *p) {
+    return tick16_venceu(tick16(), p->proximo);
+}
+
+#endif
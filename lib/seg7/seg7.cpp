@@ -0,0 +1,69 @@
+/*
+ * ================================================================================
+ * SEG7 - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "seg7.h"
+
+// Um bit do dígito: tira o peso se couber. Depois das centenas o resto é
+// < 100 e as comparações passam a 8 bits
+#define SEG7_PESO(v, peso, bit)     if ((v) >= (peso)) { (v) -= (peso); d |= (bit); }
+
+void seg7_bcd16(uint16_t v, uint8_t bcd[SEG7_DIGITOS_MAX]) {
+    uint8_t d = 0;
+    SEG7_PESO(v, 40000, 4) SEG7_PESO(v, 20000, 2) SEG7_PESO(v, 10000, 1)
+    bcd[4] = d;
+    d = 0;
+    SEG7_PESO(v, 8000, 8) SEG7_PESO(v, 4000, 4) SEG7_PESO(v, 2000, 2) SEG7_PESO(v, 1000, 1)
+    bcd[3] = d;
+    d = 0;
+    SEG7_PESO(v, 800, 8) SEG7_PESO(v, 400, 4) SEG7_PESO(v, 200, 2) SEG7_PESO(v, 100, 1)
+    bcd[2] = d;
+    d = 0;
+    uint8_t r = (uint8_t)v;
+    SEG7_PESO(r, 80, 8) SEG7_PESO(r, 40, 4) SEG7_PESO(r, 20, 2) SEG7_PESO(r, 10, 1)
+    bcd[1] = d;
+    bcd[0] = r;
+}
+
+// Monta da direita para a esquerda: dígitos significativos, zeros (se
+// pedidos), sinal e o resto apagado
+static uint8_t escreve(uint8_t *dig, uint8_t n, uint16_t mag, uint8_t neg, uint8_t modo) {
+    uint8_t d[SEG7_DIGITOS_MAX];
+    if (modo & SEG7_HEX) {
+        d[0] = mag & 0x0F;
+        d[1] = (mag >> 4) & 0x0F;
+        d[2] = (mag >> 8) & 0x0F;
+        d[3] = mag >> 12;
+        d[4] = 0;
+    } else {
+        seg7_bcd16(mag, d);
+    }
+    uint8_t sig = SEG7_DIGITOS_MAX;
+    while (sig > 1 && !d[sig - 1]) sig--;
+
+    if (sig + neg > n) {
+        for (uint8_t i = 0; i < n; i++) dig[i] = neg ? SEG7_ESTOURO_NEG : SEG7_ESTOURO;
+        return 1;
+    }
+
+    uint8_t *p = dig + n;
+    for (uint8_t i = 0; i < sig; i++) *--p = d[i];
+    if (modo & SEG7_ZEROS) {
+        while (p > dig + neg) *--p = 0;
+    }
+    if (neg) *--p = SEG7_MENOS;
+    while (p > dig) *--p = SEG7_APAGADO;
+    return 0;
+}
+
+uint8_t seg7_u16(uint8_t *dig, uint8_t n, uint16_t v, uint8_t modo) {
+    return escreve(dig, n, v, 0, modo);
+}
+
+// -32768 → magnitude 32768 (cabe em uint16_t)
+uint8_t seg7_s16(uint8_t *dig, uint8_t n, int16_t v, uint8_t modo) {
+    if (v < 0) return escreve(dig, n, (uint16_t)(0 - (uint16_t)v), 1, modo);
+    return escreve(dig, n, (uint16_t)v, 0, modo);
+}
@@ -0,0 +1,86 @@
+/*
+ * ================================================================================
+ * SEG7 - NÚMEROS EM N DÍGITOS DE 7 SEGMENTOS (DECIMAL/HEXA, SEM DIVISÃO)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * Converte um valor de 8/16 bits, com ou sem sinal, em códigos de glifo
+ * (um byte por dígito, dig[0] = mais à esquerda) prontos para um
+ * framebuffer de multiplexação ou para uma tabela de segmentos:
+ * - Glifos 0..15 = dígitos 0..F; depois apagado, "-" e os de estouro.
+ *   SEG7_PADROES() lista os padrões GFEDCBA na ordem dos códigos; cada
+ *   módulo monta a sua tabela com ela (RAM, flash, espalhada por portas)
+ * - Alinhado à direita, zeros à esquerda apagados (SEG7_ZEROS mantém) e
+ *   o "-" logo antes do dígito mais significativo (com SEG7_ZEROS, na
+ *   primeira posição). O dígito das unidades sempre aparece
+ * - Não coube (dígitos + sinal > n): todos os dígitos com o glifo de
+ *   estouro (segmento A no positivo, D no negativo) e retorno 1
+ * - Decimal sem a divisão de software do AVR (__udivmodhi4, ~200 ciclos
+ *   por chamada, 5 chamadas de /10 e %10 por valor de 16 bits): subtração
+ *   de pesos k·10^n tabelados, 15 comparações desenroladas, tempo fixo de
+ *   ~100 ciclos qualquer que seja o valor. Hexa sai direto dos nibbles.
+ *   Comparação medida no simavr: bench/seg7_ciclos.cpp
+ * ================================================================================
+ */
+
+#ifndef SEG7_H
+#define SEG7_H
+
+#include <stdint.h>
+
+// Códigos de glifo (0..15 = dígitos hexa)
+#define SEG7_APAGADO        16
+#define SEG7_MENOS          17
+#define SEG7_ESTOURO        18      // "‾": positivo que não coube
+#define SEG7_ESTOURO_NEG    19      // "_": negativo que não coube
+#define SEG7_N              20
+
+// Modo
+#define SEG7_DEC            0x00
+#define SEG7_HEX            0x01
+#define SEG7_ZEROS          0x02    // Mantém os zeros à esquerda
+
+#define SEG7_DIGITOS_MAX    5       // 65535 / -32768 (sem o sinal)
+
+// Padrões de cada glifo, cátodo comum, bits GFEDCBA. X(padrao) por glifo,
+// na ordem dos códigos
+#define SEG7_PADROES(X)                                                     \
+    X(0b00111111)   /* 0: A B C D E F */                                    \
+    X(0b00000110)   /* 1: B C */                                            \
+    X(0b01011011)   /* 2: A B D E G */                                      \
+    X(0b01001111)   /* 3: A B C D G */                                      \
+    X(0b01100110)   /* 4: B C F G */                                        \
+    X(0b01101101)   /* 5: A C D F G */                                      \
+    X(0b01111101)   /* 6: A C D E F G */                                    \
+    X(0b00000111)   /* 7: A B C */                                          \
+    X(0b01111111)   /* 8: A B C D E F G */                                  \
+    X(0b01101111)   /* 9: A B C D F G */                                    \
+    X(0b01110111)   /* A: A B C E F G */                                    \
+    X(0b01111100)   /* b: C D E F G */                                      \
+    X(0b00111001)   /* C: A D E F */                                        \
+    X(0b01011110)   /* d: B C D E G */                                      \
+    X(0b01111001)   /* E: A D E F G */                                      \
+    X(0b01110001)   /* F: A E F G */                                        \
+    X(0b00000000)   /* apagado */                                           \
+    X(0b01000000)   /* -: G */                                              \
+    X(0b00000001)   /* estouro: A */                                        \
+    X(0b00001000)   /* estouro negativo: D */
+
+#define SEG7_BYTE(p)        (uint8_t)(p),
+
+// bcd[0] = unidades ... bcd[4] = dezenas de milhar
+void seg7_bcd16(uint16_t v, uint8_t bcd[SEG7_DIGITOS_MAX]);
+
+// Retorno: 1 = estouro (dígitos com o glifo de estouro)
+uint8_t seg7_u16(uint8_t *dig, uint8_t n, uint16_t v, uint8_t modo);
+uint8_t seg7_s16(uint8_t *dig, uint8_t n, int16_t v, uint8_t modo);
+
+static inline uint8_t seg7_u8(uint8_t *dig, uint8_t n, uint8_t v, uint8_t modo) {
+    return seg7_u16(dig, n, v, modo);
+}
+
+static inline uint8_t seg7_s8(uint8_t *dig, uint8_t n, int8_t v, uint8_t modo) {
+    return seg7_s16(dig, n, v, modo);
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * ================================================================================
+ * SERIAL - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "serial.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+// Impede o compilador de reordenar acessos à fila em torno dos índices
+#define BARREIRA()  __asm__ __volatile__ ("" ::: "memory")
+
+#define SERIAL_UBRR ((F_CPU / (8UL * SERIAL_BAUD)) - 1)
+
+static_assert((SERIAL_TX_N & (SERIAL_TX_N - 1)) == 0 && SERIAL_TX_N <= 128, "SERIAL_TX_N deve ser potência de 2 até 128");
+static_assert(SERIAL_UBRR <= 4095, "SERIAL_BAUD baixo demais");
+
+volatile uint8_t serial_descartados = 0;
+
+// Fila SPSC: 'fim' só é escrito pelo loop, 'ini' só pela ISR
+static uint8_t fila[SERIAL_TX_N];
+static volatile uint8_t fila_ini = 0;
+static volatile uint8_t fila_fim = 0;
+static uint8_t enviando = 0;    // TXC0 limpo no último serial_envia()
+
+void serial_init() {
+    uint8_t sreg = SREG;
+    cli();
+    fila_ini = fila_fim = 0;
+    enviando = 0;
+    UBRR0 = SERIAL_UBRR;
+    UCSR0A = (1 << U2X0);
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);     // 8N1
+    UCSR0B = (1 << RXEN0) | (1 << TXEN0);       // UDRIE0 só com dados na fila
+    SREG = sreg;
+}
+
+uint8_t serial_livre() {
+    return (uint8_t)(SERIAL_TX_N - 1 - ((fila_fim - fila_ini) & (SERIAL_TX_N - 1)));
+}
+
+uint8_t serial_envia(const void *dados, uint8_t n) {
+    if (n > serial_livre()) {
+        serial_descartados++;
+        return 0;
+    }
+    const uint8_t *p = (const uint8_t *)dados;
+    uint8_t fim = fila_fim;
+    while (n--) {
+        fila[fim] = *p++;
+        fim = (fim + 1) & (SERIAL_TX_N - 1);
+    }
+    BARREIRA();
+    fila_fim = fim;
+    
+    // UCSR0B também é alterado pela ISR: read-modify-write atômico.
+    // TXC0 (escrever 1 limpa) volta a 1 quando o último byte sair da linha
+    uint8_t sreg = SREG;
+    cli();
+    UCSR0A = (uint8_t)((UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0));
+    enviando = 1;
+    UCSR0B |= (1 << UDRIE0);
+    SREG = sreg;
+    return 1;
+}
+
+void serial_envia_espera(const void *dados, uint8_t n) {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (serial_livre() < n) sleep_mode();    // UDRE acorda a cada byte
+    serial_envia(dados, n);
+}
+
+ISR(USART_UDRE_vect) {
+    uint8_t ini = fila_ini;
+    if (ini == fila_fim) {
+        UCSR0B &= ~(1 << UDRIE0);
+        return;
+    }
+    UDR0 = fila[ini];
+    fila_ini = (ini + 1) & (SERIAL_TX_N - 1);
+    if (fila_ini == fila_fim) UCSR0B &= ~(1 << UDRIE0);
+}
+
+// Fila vazia e o último byte já fora do registrador de deslocamento
+uint8_t serial_ocioso() {
+    if (fila_ini != fila_fim) return 0;
+    if (enviando && !(UCSR0A & (1 << TXC0))) return 0;
+    enviando = 0;
+    return 1;
+}
+
+uint8_t serial_le(uint8_t *c) {
+    if (!(UCSR0A & (1 << RXC0))) return 0;
+    *c = UDR0;
+    return 1;
+}
@@ -0,0 +1,42 @@
+/*
+ * ================================================================================
+ * SERIAL - USART0 COM FILA DE TRANSMISSÃO ESVAZIADA PELA ISR (UDRE)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * - 8N1 com U2X; SERIAL_BAUD padrão 500000 (UBRR0 = 3, erro 0%)
+ * - serial_envia() copia para a fila circular e retorna na hora: o loop
+ *   nunca espera a UART. Sem espaço para a mensagem inteira → descarta
+ *   tudo e conta em serial_descartados (nunca envia meia mensagem)
+ * - A ISR USART_UDRE envia 1 byte por interrupção e se desliga quando a
+ *   fila esvazia
+ * - serial_envia_espera(): versão bloqueante (dorme em IDLE até caber,
+ *   n < SERIAL_TX_N), só para depuração
+ * - serial_ocioso(): nada na fila nem na linha (pode desligar o clock)
+ * - Recepção por polling: serial_le()
+ * ================================================================================
+ */
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include <stdint.h>
+
+#ifndef SERIAL_BAUD
+#define SERIAL_BAUD         500000UL
+#endif
+
+#ifndef SERIAL_TX_N
+#define SERIAL_TX_N         64      // Potência de 2
+#endif
+
+extern volatile uint8_t serial_descartados;
+
+void serial_init();
+uint8_t serial_envia(const void *dados, uint8_t n);
+void serial_envia_espera(const void *dados, uint8_t n);
+uint8_t serial_livre();
+uint8_t serial_ocioso();
+uint8_t serial_le(uint8_t *c);
+
+#endif
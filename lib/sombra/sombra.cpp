@@ -0,0 +1,85 @@
+/*
+ * ================================================================================
+ * SOMBRA - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "sombra.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "trace.h"
+
+uint8_t sombra[3];
+uint16_t sombra_escritas = 0;
+
+static uint8_t s_mascara[3];    // Bits controlados pela sombra
+static uint8_t s_escrito[3];    // Valor levado aos pinos no último commit
+
+typedef struct {
+    uint8_t de;                 // 0xFF = livre
+    uint8_t para;
+} espelho_t;
+
+static espelho_t s_espelhos[SOMBRA_ESPELHOS] = { { 0xFF, 0 }, { 0xFF, 0 } };
+
+void sombra_sincroniza() {
+    uint8_t sreg = SREG;
+    cli();
+    sombra[SOMBRA_B] = s_escrito[SOMBRA_B] = PORTB;
+    sombra[SOMBRA_C] = s_escrito[SOMBRA_C] = PORTC;
+    sombra[SOMBRA_D] = s_escrito[SOMBRA_D] = PORTD;
+    SREG = sreg;
+}
+
+void sombra_inicia(uint8_t b, uint8_t c, uint8_t d) {
+    s_mascara[SOMBRA_B] = b;
+    s_mascara[SOMBRA_C] = c;
+    s_mascara[SOMBRA_D] = d;
+    for (uint8_t i = 0; i < SOMBRA_ESPELHOS; i++) s_espelhos[i].de = 0xFF;
+    sombra_sincroniza();
+}
+
+void sombra_espelho(uint8_t de, uint8_t para) {
+    for (uint8_t i = 0; i < SOMBRA_ESPELHOS; i++) {
+        espelho_t *e = &s_espelhos[i];
+        if (e->de == 0xFF || e->para == para) {
+            e->de = de;
+            e->para = para;
+            return;
+        }
+    }
+}
+
+void sombra_para() {
+    s_mascara[SOMBRA_B] = s_mascara[SOMBRA_C] = s_mascara[SOMBRA_D] = 0;
+    for (uint8_t i = 0; i < SOMBRA_ESPELHOS; i++) s_espelhos[i].de = 0xFF;
+}
+
+// Bits mudados e controlados: uma escrita mascarada na porta
+#define SOMBRA_ESCREVE(i, PORTx, id) do {                               \
+    uint8_t m = (sombra[i] ^ s_escrito[i]) & s_mascara[i];              \
+    if (m) {                                                            \
+        PORTx = (PORTx & ~m) | (sombra[i] & m);                         \
+        s_escrito[i] ^= m;                                              \
+        sombra_escritas++;                                              \
+        TRACE_ISR(id);                                                  \
+    }                                                                   \
+} while (0)
+
+// Espelhos e escritas com as interrupções desligadas: um commit da ISR
+// nunca intercala com um do loop
+void sombra_commit() {
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t i = 0; i < SOMBRA_ESPELHOS; i++) {
+        espelho_t *e = &s_espelhos[i];
+        if (e->de == 0xFF) continue;
+        uint8_t bit = (uint8_t)(1 << (e->para & 7));
+        if ((sombra[e->de >> 3] >> (e->de & 7)) & 1) sombra[e->para >> 3] |= bit;
+        else sombra[e->para >> 3] &= ~bit;
+    }
+    SOMBRA_ESCREVE(SOMBRA_B, PORTB, TRACE_PORTB);
+    SOMBRA_ESCREVE(SOMBRA_C, PORTC, TRACE_PORTC);
+    SOMBRA_ESCREVE(SOMBRA_D, PORTD, TRACE_PORTD);
+    SREG = sreg;
+}
@@ -0,0 +1,55 @@
+/*
+ * ================================================================================
+ * SOMBRA - CÓPIAS DE PORTB/C/D EM RAM COM UM COMMIT MASCARADO POR PASSO
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * A lógica dos exercícios escreve só nas cópias (SOMBRA_PORTx, com os
+ * SET_BIT/CLR_BIT de sempre); sombra_commit() leva o resultado para os
+ * pinos de uma vez:
+ * - Só os bits que mudaram desde o último commit e que a sombra controla
+ *   (máscaras de sombra_inicia) são escritos: 1 escrita mascarada por porta
+ *   que mudou, nenhuma se nada mudou. Bits fora da máscara ou não mexidos
+ *   na sombra ficam com quem os escreveu direto (lib/led, lib/botoes)
+ * - "Apaga todos, acende um" ou quatro LEDs em duas portas viram o estado
+ *   final numa escrita por porta: nenhum pulso intermediário nos pinos
+ * - As portas são escritas em sequência com as interrupções desligadas
+ *   (~15 ciclos entre a primeira e a última): uma ISR nunca vê metade
+ *   da mudança
+ * - Espelhos: pino virtual → físico aplicado no commit (ex.: D7 do
+ *   bargraph, PB7 na lógica, sai em PC0)
+ * - Escritas na sombra vêm de um contexto por vez (o loop ou a ISR de 1ms)
+ * - sombra_escritas conta as escritas em PORTx feitas pelos commits
+ * ================================================================================
+ */
+
+#ifndef SOMBRA_H
+#define SOMBRA_H
+
+#include <stdint.h>
+
+#define SOMBRA_B            0
+#define SOMBRA_C            1
+#define SOMBRA_D            2
+#define SOMBRA_PINO(porta, bit)     ((uint8_t)(((porta) << 3) | (bit)))
+
+#define SOMBRA_ESPELHOS     2
+
+extern uint8_t sombra[3];                   // Cópias de PORTB, PORTC, PORTD
+extern uint16_t sombra_escritas;
+
+#define SOMBRA_PORTB        sombra[SOMBRA_B]
+#define SOMBRA_PORTC        sombra[SOMBRA_C]
+#define SOMBRA_PORTD        sombra[SOMBRA_D]
+
+// Bits que a sombra controla em cada porta; as cópias partem de PORTx e
+// os espelhos são desfeitos
+void sombra_inicia(uint8_t b, uint8_t c, uint8_t d);
+// 'para' recebe o nível de 'de' a cada commit (pinos de SOMBRA_PINO)
+void sombra_espelho(uint8_t de, uint8_t para);
+// Relê PORTx: bits escritos por fora passam a valer na sombra
+void sombra_sincroniza();
+void sombra_commit();
+void sombra_para();
+
+#endif
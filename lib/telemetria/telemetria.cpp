@@ -0,0 +1,51 @@
+/*
+ * ================================================================================
+ * TELEMETRIA - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "telemetria.h"
+#include "serial.h"
+#include "scheduler.h"
+#include <avr/io.h>
+
+static uint8_t seq = 0;
+static unsigned long execucoes_ant = 0;
+static unsigned long dormidas_ant = 0;
+static unsigned long perdidos_ant = 0;
+static unsigned long deriva_ant = 0;
+
+// Retorna 0 se o quadro foi descartado (fila da serial cheia)
+uint8_t telemetria_envia(uint8_t exercicio, uint8_t botoes) {
+    telemetria_quadro_t q;
+    q.sync = TELEMETRIA_SYNC;
+    q.seq = seq++;
+    q.exercicio = exercicio;
+    q.portb = PORTB;
+    q.portc = PORTC;
+    q.portd = PORTD;
+    q.botoes = botoes;
+    q.execucoes = (uint16_t)(sched_execucoes - execucoes_ant);
+    q.dormidas = (uint16_t)(sched_dormidas - dormidas_ant);
+    q.perdidos = (uint16_t)(sched_perdidos - perdidos_ant);
+    q.deriva = (uint16_t)(sched_deriva - deriva_ant);
+    execucoes_ant = sched_execucoes;
+    dormidas_ant = sched_dormidas;
+    perdidos_ant = sched_perdidos;
+    deriva_ant = sched_deriva;
+    
+    const uint8_t *p = (const uint8_t *)&q;
+    uint8_t x = 0;
+    for (uint8_t i = 0; i < sizeof(q) - 1; i++) x ^= p[i];
+    q.xor_ = x;
+    
+    return serial_envia(&q, sizeof(q));
+}
+
+// 'seq' continua: quem recebe segue detectando quadros perdidos
+void telemetria_reinicia() {
+    execucoes_ant = 0;
+    dormidas_ant = 0;
+    perdidos_ant = 0;
+    deriva_ant = 0;
+}
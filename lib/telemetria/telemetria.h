@@ -0,0 +1,59 @@
+/*
+ * ================================================================================
+ * TELEMETRIA - QUADRO BINÁRIO PERIÓDICO PELA SERIAL
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * Quadro de 16 bytes (little-endian), enviado por serial_envia() (nunca
+ * bloqueia; sem espaço na fila o quadro é descartado e 'seq' denuncia):
+ *   [0]  0xA5  sincronismo
+ *   [1]  seq   contador de quadros (detecta perdas)
+ *   [2]  exercicio_atual
+ *   [3]  PORTB   [4] PORTC   [5] PORTD   (latches de saída)
+ *   [6]  botões debounçados (bits de PORTC)
+ *   [7]  execuções de tarefas desde o quadro anterior (uint16)
+ *   [9]  entradas em sleep desde o quadro anterior (uint16)
+ *        → loop()/período = execuções + sleeps
+ *   [11] períodos perdidos (sched_per_t) desde o quadro anterior (uint16)
+ *   [13] deriva desde o quadro anterior (ms, uint16) - só SCHED_RESSINC
+ *        gera deriva; somada por exercício ([2]) dá a deriva acumulada
+ *   [15] XOR dos bytes 0..14
+ * A 500000 baud o quadro ocupa ~320µs de linha e 16 ISRs curtas: pode
+ * ficar ligado sempre (TELEMETRIA_MS = 250 → <0,1% da CPU).
+ * ================================================================================
+ */
+
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <stdint.h>
+
+#ifndef TELEMETRIA_MS
+#define TELEMETRIA_MS       250
+#endif
+
+#define TELEMETRIA_SYNC     0xA5
+
+typedef struct __attribute__((packed)) {
+    uint8_t sync;
+    uint8_t seq;
+    uint8_t exercicio;
+    uint8_t portb;
+    uint8_t portc;
+    uint8_t portd;
+    uint8_t botoes;
+    uint16_t execucoes;
+    uint16_t dormidas;
+    uint16_t perdidos;
+    uint16_t deriva;
+    uint8_t xor_;
+} telemetria_quadro_t;
+
+static_assert(sizeof(telemetria_quadro_t) == 16, "quadro de telemetria deve ter 16 bytes");
+
+uint8_t telemetria_envia(uint8_t exercicio, uint8_t botoes);
+// Depois de sched_limpa() (contadores zerados): o próximo quadro conta
+// desde zero, sem diferença negativa virando 65xxx
+void telemetria_reinicia();
+
+#endif
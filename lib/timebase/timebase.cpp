@@ -0,0 +1,49 @@
+/*
+ * ================================================================================
+ * TIMEBASE - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "timebase.h"
+#include <avr/sleep.h>
+#include "trace.h"
+
+volatile unsigned long timer_millis = 0;
+
+void timer1_init() {
+    cli();
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    OCR1A = TIMEBASE_OCR;
+    TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);  // CTC, prescaler 64
+    TIFR1 = (1 << OCF1A);                                // Limpa flag pendente
+    TIMSK1 |= (1 << OCIE1A);
+    sei();
+}
+
+ISR(TIMER1_COMPA_vect) {
+    timer_millis++;
+    TRACE_ISR(TRACE_T1_ISR);
+    if (timebase_tick_hook) timebase_tick_hook();
+}
+
+unsigned long micros_custom() {
+    uint8_t sreg = SREG;
+    cli();
+    unsigned long m = timer_millis;
+    uint16_t t = TCNT1;
+    // Compare já ocorreu mas a ISR ainda não rodou: TCNT1 voltou a 0,
+    // então o ms pendente ainda não está em timer_millis
+    if ((TIFR1 & (1 << OCF1A)) && t < (TIMEBASE_OCR / 2)) m++;
+    SREG = sreg;
+    return m * 1000UL + (unsigned long)(t * TIMEBASE_US_TICK);
+}
+
+// Dorme em IDLE entre os ticks em vez de girar no laço: o tick de 1ms
+// sempre acorda a CPU (exige interrupções ligadas, como antes)
+void delay_ms(unsigned long ms) {
+    unsigned long start = millis_custom();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while ((millis_custom() - start) < ms) sleep_mode();
+}
@@ -0,0 +1,82 @@
+/*
+ * ================================================================================
+ * TIMEBASE - BASE DE TEMPO COMPARTILHADA (Timer1 - 1ms)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * Timer1 em modo CTC, prescaler 64, OCR1A = 249 → 1 interrupção por ms.
+ * - millis_custom(): contador de ms (32 bits), leitura atômica que PRESERVA
+ *   o estado do bit I (pode ser chamada com interrupções desligadas)
+ * - micros_custom(): ms * 1000 + TCNT1 * 4 (resolução de 4µs)
+ * - tick16(): só os 16 bits baixos do contador (tick16_t), para intervalos
+ *   curtos (< 32768 ms): timestamps dos exercícios, deadlines do
+ *   escalonador, frames de animação. Metade da RAM e metade das instruções
+ *   de cópia/subtração/comparação; millis_custom() fica para durações longas
+ * - delay_ms(): espera baseada em millis_custom(), dormindo em IDLE entre ticks
+ * - timebase_tick_hook(): opcional (símbolo weak); se a aplicação definir,
+ *   é chamada dentro da ISR a cada 1ms (manter curta!)
+ * ================================================================================
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#define TIMEBASE_OCR        249     // (16MHz / 64 / 1000Hz) - 1
+#define TIMEBASE_US_TICK    4       // 64 / 16MHz = 4µs por contagem de TCNT1
+
+extern volatile unsigned long timer_millis;
+
+void timer1_init();
+void timebase_tick_hook() __attribute__((weak));
+unsigned long micros_custom();
+void delay_ms(unsigned long ms);
+
+// Função mais chamada do firmware: inline, sem cli()/sei() incondicionais.
+// Salva SREG, desliga interrupções só durante a cópia dos 4 bytes e restaura.
+static inline unsigned long millis_custom() {
+    uint8_t sreg = SREG;
+    cli();
+    unsigned long m = timer_millis;
+    SREG = sreg;
+    return m;
+}
+
+// ================================================================================
+// TICK DE 16 BITS (intervalos curtos)
+// ================================================================================
+typedef uint16_t tick16_t;
+
+// Só os 2 bytes baixos de timer_millis (little-endian): 2 LDS em vez de 4.
+// Sem proteção - direto só dentro de ISR (interrupções já desligadas)
+static inline tick16_t tick16_isr() {
+    const volatile uint8_t *p = (const volatile uint8_t *)&timer_millis;
+    return p[0] | ((tick16_t)p[1] << 8);
+}
+
+static inline tick16_t tick16() {
+    uint8_t sreg = SREG;
+    cli();
+    tick16_t t = tick16_isr();
+    SREG = sreg;
+    return t;
+}
+
+// Diferença com sinal, segura no wrap enquanto |a - b| < 32768 ms
+static inline int16_t tick16_dif(tick16_t a, tick16_t b) {
+    return (int16_t)(tick16_t)(a - b);
+}
+
+// 'agora' já alcançou 'deadline'
+static inline uint8_t tick16_venceu(tick16_t agora, tick16_t deadline) {
+    return tick16_dif(agora, deadline) >= 0;
+}
+
+// Passaram pelo menos 'intervalo' ms desde 'desde'
+static inline uint8_t tick16_passou(tick16_t desde, uint16_t intervalo) {
+    return (tick16_t)(tick16() - desde) >= intervalo;
+}
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * ================================================================================
+ * TIMER2 - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "timer2.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+static timer2_compb_t s_compb = 0;
+
+void timer2_compb(timer2_compb_t f) {
+    uint8_t sreg = SREG;
+    cli();
+    s_compb = f;
+    SREG = sreg;
+}
+
+ISR(TIMER2_COMPB_vect) {
+    timer2_compb_t f = s_compb;
+    if (f) f();
+}
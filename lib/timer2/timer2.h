@@ -0,0 +1,28 @@
+/*
+ * ================================================================================
+ * TIMER2 - DONO ÚNICO DA ISR DE COMPARE B
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * lib/led (pisca do PD3/OC2B) e lib/bam (planos do bargraph) usam o compare
+ * B do Timer2, em momentos diferentes. O vetor é um só: esta lib define a
+ * ISR(TIMER2_COMPB_vect) e chama o tratador registrado por quem está com o
+ * Timer2. As duas libs podem entrar na mesma imagem (firmware único) ou no
+ * mesmo teste; quem liga o OCIE2B registra o seu tratador antes
+ * - timer2_compb(f): f passa a ser chamado a cada compare B (0 = nenhum).
+ *   Não mexe no Timer2 nem no OCIE2B: configurar e soltar é de quem usa
+ * - Custo: uma chamada indireta dentro da ISR (icall + os registradores
+ *   que o compilador salva por não conhecer f, ~30 ciclos a mais)
+ * - O modo do Timer2 continua sendo um só: lib/led e lib/bam (e a
+ *   multiplexação do Módulo 2, no compare A) se revezam, nunca juntos
+ * ================================================================================
+ */
+
+#ifndef TIMER2_H
+#define TIMER2_H
+
+typedef void (*timer2_compb_t)();
+
+void timer2_compb(timer2_compb_t f);
+
+#endif
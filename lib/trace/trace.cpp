@@ -0,0 +1,50 @@
+/*
+ * ================================================================================
+ * TRACE - IMPLEMENTAÇÃO
+ * ================================================================================
+ */
+
+#include "trace.h"
+#include "serial.h"
+
+#if TRACE_ATIVO
+
+trace_reg_t trace_buf[TRACE_N];
+uint8_t trace_pos = 0;
+uint8_t trace_pausado = 0;
+
+void trace_init() {
+    serial_init();
+}
+
+static uint8_t hex(uint8_t n) {
+    return n < 10 ? '0' + n : 'A' - 10 + n;
+}
+
+// Linha por registro: "tick tcnt id\n" em hexa (mais antigo primeiro).
+// Despejo é raro e só para depuração: espera a fila da serial esvaziar.
+void trace_dump() {
+    trace_pausado = 1;
+    uint8_t i = trace_pos;
+    for (uint8_t n = 0; n < TRACE_N; n++) {
+        const trace_reg_t *r = &trace_buf[i];
+        if (r->id || r->tick || r->tcnt) {
+            uint8_t linha[12] = {
+                hex(r->tick >> 12), hex((r->tick >> 8) & 0x0F), hex((r->tick >> 4) & 0x0F), hex(r->tick & 0x0F), ' ',
+                hex((r->tcnt >> 8) & 0x0F), hex((r->tcnt >> 4) & 0x0F), hex(r->tcnt & 0x0F), ' ',
+                hex(r->id >> 4), hex(r->id & 0x0F), '\n'
+            };
+            serial_envia_espera(linha, sizeof(linha));
+        }
+        i = (i + 1) & (TRACE_N - 1);
+    }
+    serial_envia_espera(".\n", 2);
+    trace_pausado = 0;
+}
+
+void trace_comando() {
+    uint8_t c;
+    if (serial_le(&c) && c == 'd') trace_dump();
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * ================================================================================
+ * TRACE - REGISTRO DE EVENTOS EM RAM COM CARIMBO DE TEMPO (Timer1)
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ * 
+ * - Só existe com -DTRACE_ATIVO=1; desligado, TRACE()/TRACE_ISR() somem
+ *   (custo zero de flash, RAM e ciclos)
+ * - Cada registro: id do evento + tick16_isr() + TCNT1
+ *   → tempo = tick * 1000µs + tcnt * 4µs
+ * - Buffer circular de TRACE_N registros: guarda sempre os mais recentes
+ * - TRACE_ISR() é para quando as interrupções já estão desligadas (ISR ou
+ *   seção cli); TRACE() pode ser usada em qualquer lugar (~20 ciclos)
+ * - trace_init() liga a serial (lib/serial); desnecessária se o módulo já
+ *   chamou serial_init()
+ * - trace_comando(): chamar no loop; um 'd' recebido pela serial
+ *   despeja o buffer em texto (uma linha por registro, do mais antigo ao
+ *   mais novo)
+ * ================================================================================
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifndef TRACE_ATIVO
+#define TRACE_ATIVO         0
+#endif
+
+#ifndef TRACE_N
+#define TRACE_N             64      // Potência de 2 (5 bytes por registro)
+#endif
+
+// Ids dos eventos
+#define TRACE_TAREFA_ENTRA  0x00    // + id da tarefa do escalonador (0x00-0x3F)
+#define TRACE_TAREFA_SAI    0x40    // + id da tarefa (0x40-0x7F)
+#define TRACE_T1_ISR        0x80    // ISR(TIMER1_COMPA_vect)
+#define TRACE_BOTOES        0x81    // botoes_tick() (amostragem dos botões)
+#define TRACE_PORTB         0x82    // Escrita de frame/segmentos em PORTB
+#define TRACE_PORTD         0x83    // Escrita de segmentos em PORTD
+#define TRACE_PORTC         0x84    // Escrita em PORTC (commit de lib/sombra)
+
+#if TRACE_ATIVO
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "timebase.h"
+
+static_assert((TRACE_N & (TRACE_N - 1)) == 0 && TRACE_N <= 128, "TRACE_N deve ser potência de 2 até 128");
+
+typedef struct {
+    uint8_t id;
+    tick16_t tick;                  // tick16_isr()
+    uint16_t tcnt;                  // TCNT1 (4µs por contagem)
+} trace_reg_t;
+
+extern trace_reg_t trace_buf[TRACE_N];
+extern uint8_t trace_pos;           // Próximo registro a escrever
+extern uint8_t trace_pausado;       // 1 durante o despejo
+
+static inline void trace_isr(uint8_t id) {
+    if (trace_pausado) return;
+    trace_reg_t *r = &trace_buf[trace_pos];
+    r->id = id;
+    r->tick = tick16_isr();
+    r->tcnt = TCNT1;
+    trace_pos = (trace_pos + 1) & (TRACE_N - 1);
+}
+
+static inline void trace(uint8_t id) {
+    uint8_t sreg = SREG;
+    cli();
+    trace_isr(id);
+    SREG = sreg;
+}
+
+void trace_init();
+void trace_dump();
+void trace_comando();
+
+#define TRACE(id)           trace(id)
+#define TRACE_ISR(id)       trace_isr(id)
+
+#else
+
+#define TRACE(id)           ((void)0)
+#define TRACE_ISR(id)       ((void)0)
+
+static inline void trace_init() {}
+static inline void trace_dump() {}
+static inline void trace_comando() {}
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * ================================================================================
+ * FIRMWARE ÚNICO - OS 21 EXERCÍCIOS NUMA IMAGEM, TROCADOS PELA SERIAL
+ * ================================================================================
+ * Microcontrolador: ATmega328P @ 16MHz
+ *
+ * Ambiente "unico" (pio run -e unico): os três módulos compilados juntos
+ * com -DFIRMWARE_UNICO. Cada um exporta seu modulo_t (lib/modulo); este
+ * arquivo tem o setup()/loop() e a tabela de módulos.
+ *
+ * NUMERAÇÃO (exercício global 0-20):
+ *   0-9   → Módulo 1 (1.1, 1.2a ... 1.2i)
+ *   10    → Módulo 2 (displays multiplexados)
+ *   11-20 → Módulo 3 (3.1 ... 3.10)
+ *
+ * COMANDOS (USART0, 500000 8N1):
+ *   'a'..'u'   vai direto para o exercício global 0..20
+ *   '+' / '-'  próximo / anterior
+ *   'd'        despeja o trace (só com TRACE_ATIVO)
+ *
+ * Na troca, o módulo que sai desliga suas ISRs/timers e seus pinos voltam
+ * a entrada sem pull-up antes do próximo configurar os dele (PORTB e PORTC
+ * são disputados pelos três módulos). O Módulo 1 continua passando
+ * sozinho pela playlist dele (cada exercício até completar as repetições),
+ * como no build separado.
+ * ================================================================================
+ */
+
+#include "boot.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "timebase.h"
+#include "serial.h"
+#include "trace.h"
+#include "modulo.h"
+
+static const modulo_t *const MODULOS[] = { &MODULO1, &MODULO2, &MODULO3 };
+#define NUM_MODULOS     (sizeof(MODULOS) / sizeof(MODULOS[0]))
+
+uint8_t exercicio_global = 0;
+
+static uint8_t total_exercicios() {
+    uint8_t n = 0;
+    for (uint8_t m = 0; m < NUM_MODULOS; m++) n += pgm_read_byte(&MODULOS[m]->n);
+    return n;
+}
+
+// Acha o módulo do exercício global e troca para ele
+void seleciona_exercicio(uint8_t g) {
+    if (g >= total_exercicios()) g = 0;
+    exercicio_global = g;
+
+    for (uint8_t m = 0; m < NUM_MODULOS; m++) {
+        uint8_t n = pgm_read_byte(&MODULOS[m]->n);
+        if (g < n) {
+            modulo_troca(MODULOS[m], pgm_read_byte(&MODULOS[m]->primeiro) + g);
+            return;
+        }
+        g -= n;
+    }
+}
+
+static void comando(uint8_t c) {
+    uint8_t total = total_exercicios();
+
+    if (c >= 'a' && c < 'a' + total) {
+        seleciona_exercicio(c - 'a');
+    } else if (c == '+') {
+        seleciona_exercicio(exercicio_global + 1 < total ? exercicio_global + 1 : 0);
+    } else if (c == '-') {
+        seleciona_exercicio(exercicio_global ? exercicio_global - 1 : total - 1);
+    } else if (c == 'd') {
+        trace_dump();
+    }
+}
+
+// Chamado dentro da ISR do Timer1 (1ms): repassa ao módulo ativo
+void timebase_tick_hook() {
+    modulo_tick();
+}
+
+void setup() {
+    timer1_init();
+    trace_init();
+    serial_init();
+    seleciona_exercicio(0);
+}
+
+void loop() {
+    uint8_t c;
+    if (serial_le(&c)) comando(c);
+    modulo_atual.passo();
+}
@@ -4,490 +4,395 @@
  * 
  */
 
-#include <Arduino.h> 
+#include "boot.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
-
-#define SET_BIT(REG, BIT)   (REG |= (1 << BIT))
-#define CLR_BIT(REG, BIT)   (REG &= ~(1 << BIT))
-#define TGL_BIT(REG, BIT)   (REG ^= (1 << BIT))
-#define READ_BIT(REG, BIT)  ((REG >> BIT) & 1)
+#include <string.h>
+#include "timebase.h"
+#include "scheduler.h"
+#include "anim.h"
+#include "anim_frames.h"
+#include "anim_stream.h"
+#include "trace.h"
+#include "serial.h"
+#include "telemetria.h"
+#include "modulo.h"
+#include "sombra.h"
+#include "bam.h"
 
 #define LED_TESTE_PIN   5
 #define LED_D7_PIN      0
 
-volatile unsigned long timer_millis = 0;
-uint8_t exercicio_atual = 0;
-unsigned long exercise_start_time = 0;
-unsigned long exercise_duration = 2000;
+#define M1_PINOS_C      ((1 << LED_TESTE_PIN) | (1 << LED_D7_PIN))
 
-// Função auxiliar para atualizar D7 baseado em PORTB
-inline void update_d7() {
-    if (READ_BIT(PORTB, 7)) SET_BIT(PORTC, LED_D7_PIN);
-    else CLR_BIT(PORTC, LED_D7_PIN);
-}
+static uint8_t exercicio_atual = 0;
 
-void timer1_init() {
-    cli();
-    TCCR1A = 0;
-    TCCR1B = 0;
-    TCNT1 = 0;
-    OCR1A = 249;
-    SET_BIT(TCCR1B, WGM12);
-    SET_BIT(TCCR1B, CS11);
-    SET_BIT(TCCR1B, CS10);
-    SET_BIT(TIMSK1, OCIE1A);
-    sei();
+// ================================================================================
+// SAÍDAS DAS ANIMAÇÕES (lib/sombra)
+// ================================================================================
+// Os frames vão para as cópias de PORTB/PORTC; o commit (fim do passo do
+// loop ou ISR do stream) escreve as portas de uma vez. O D7 do bargraph é
+// o PB7 da lógica, espelhado em PC0 no commit
+void saida_bargraph(uint8_t frame) {
+    SOMBRA_PORTB = frame;
 }
 
-ISR(TIMER1_COMPA_vect) {
-    timer_millis++;
+// ================================================================================
+// RASTRO PELO BAM (1.2c, 1.2d)
+// ================================================================================
+// A cada frame do stream o brilho de todos cai pela metade e os LEDs do
+// frame acendem inteiros; lib/bam mostra com 256 níveis (gamma 2,2:
+// 255/127/63/31 saem como 255/55/12/2, cauda de ~3 LEDs). O BAM escreve
+// PORTB direto, então a sombra larga PORTB enquanto ele roda; o D7 (PC0)
+// segue pelo espelho, só com a cabeça (aceso ou apagado, sem rastro)
+static uint8_t rastro_ativo = 0;
+static uint8_t brilho[BAM_CANAIS];
+
+// A ISR de 1ms só entrega o frame; gamma, transposição e bam_publica()
+// rodam no loop (~500 ciclos: com as interrupções desligadas passariam do
+// plano mais curto do BAM, 512 ciclos, e o quadro sairia errado)
+static volatile uint8_t rastro_frame;
+static volatile uint8_t rastro_pendente = 0;
+
+static void saida_rastro(uint8_t frame) {
+    for (uint8_t i = 0; i < BAM_CANAIS; i++) {
+        brilho[i] >>= 1;
+        if ((frame >> i) & 1) brilho[i] = 255;
+    }
+    bam_publica(brilho);
 }
 
-unsigned long millis_custom() {
-    unsigned long m;
-    cli();
-    m = timer_millis;
-    sei();
-    return m;
+// PORTB: da sombra (com o espelho PB7 → PC0) ou do BAM
+static void bargraph_pela_sombra(uint8_t sim) {
+    sombra_inicia(sim ? 0xFF : 0x00, M1_PINOS_C, 0);
+    sombra_espelho(SOMBRA_PINO(SOMBRA_B, 7), SOMBRA_PINO(SOMBRA_C, LED_D7_PIN));
 }
 
-void delay_ms(unsigned long ms) {
-    unsigned long start = millis_custom();
-    while ((millis_custom() - start) < ms);
+void saida_teste(uint8_t frame) {
+    SOMBRA_PORTB = 0x00;
+    if (frame) SET_BIT(SOMBRA_PORTC, LED_TESTE_PIN);
+    else CLR_BIT(SOMBRA_PORTC, LED_TESTE_PIN);
 }
 
-void modulo1_ex1() {
-    static unsigned long last_toggle = 0;
-    static uint8_t fase = 0;
-    unsigned long intervalo = (fase < 6) ? 200 : 500;
-    
-    PORTB = 0x00;
-    CLR_BIT(PORTC, LED_D7_PIN);
-    
-    if (millis_custom() - last_toggle >= intervalo) {
-        last_toggle = millis_custom();
-        TGL_BIT(PORTC, LED_TESTE_PIN);
-        fase++;
-        if (fase >= 12) fase = 0;
+// ================================================================================
+// EXERCÍCIOS COMO TABELAS (PROGMEM)
+// ================================================================================
+// Ex 1.1 - LED teste: 3x rápido (200ms), 3x devagar (500ms)
+const anim_passo_t PASSOS_EX1[] PROGMEM = {
+    ANIM_PASSO(ANIM_INV,     0x00, 6,   200),
+    ANIM_PASSO(ANIM_INV,     0x00, 6,   500),
+};
+
+// Ex 1.2a - Acende acumulando do PB0 ao PB7
+const anim_passo_t PASSOS_EX2A[] PROGMEM = {
+    ANIM_PASSO(ANIM_FILL_UP, 0x01, 8,   100),
+    ANIM_PASSO(ANIM_HOLD,    0xFF, 1,   100),
+    ANIM_PASSO(ANIM_HOLD,    0x00, 1,   100),
+};
+
+// Ex 1.2b - Acende acumulando do PB7 ao PB0
+const anim_passo_t PASSOS_EX2B[] PROGMEM = {
+    ANIM_PASSO(ANIM_FILL_DN, 0x80, 8,   100),
+    ANIM_PASSO(ANIM_HOLD,    0xFF, 1,   100),
+    ANIM_PASSO(ANIM_HOLD,    0x00, 1,   100),
+};
+
+// Ex 1.2f - Acende acumulando, pisca 2x, apaga
+const anim_passo_t PASSOS_EX2F[] PROGMEM = {
+    ANIM_PASSO(ANIM_FILL_UP, 0x01, 8,   100),
+    ANIM_PASSO(ANIM_INV,     0x00, 4,   150),
+    ANIM_PASSO(ANIM_HOLD,    0x00, 1,   100),
+};
+
+// Ex 1.2h - Contagem binária 0→255
+const anim_passo_t PASSOS_EX2H[] PROGMEM = {
+    ANIM_PASSO(ANIM_INC,     0x00, 256, 150),
+};
+
+// Ex 1.2i - Contagem binária 255→0
+const anim_passo_t PASSOS_EX2I[] PROGMEM = {
+    ANIM_PASSO(ANIM_DEC,     0xFF, 256, 150),
+};
+
+// ================================================================================
+// EXERCÍCIOS GERADOS EM TEMPO DE COMPILAÇÃO (frame = função do índice)
+// ================================================================================
+// Ex 1.2c - 1 LED por vez
+struct GeraUmPorVez {
+    static constexpr uint8_t N = 8;
+    static constexpr uint8_t frame(uint8_t i) { return (uint8_t)(1 << i); }
+};
+
+// Ex 1.2d - Ping-pong (0→7→1)
+struct GeraPingPong {
+    static constexpr uint8_t N = 14;
+    static constexpr uint8_t frame(uint8_t i) { return (uint8_t)(1 << (i < 8 ? i : 14 - i)); }
+};
+
+// Ex 1.2e - Todos acesos, apaga 1 por vez e volta
+struct GeraApagaUmPorVez {
+    static constexpr uint8_t N = 17;
+    static constexpr uint8_t frame(uint8_t i) {
+        return i < 2 ? 0xFF : i < 10 ? (uint8_t)(0xFE << (i - 2)) : 0x00;
     }
-}
+};
 
-void modulo1_ex2a() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        step = 0;
-        leds = 0;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
+// Ex 1.2g - D→E acumulando, apaga, E→D acumulando
+struct GeraDireitaEsquerda {
+    static constexpr uint8_t N = 19;
+    static constexpr uint8_t frame(uint8_t i) {
+        return i < 8  ? (uint8_t)(0xFF << (7 - i)) :
+               i == 8 ? 0xFF :
+               i == 9 ? 0x00 :
+               i < 18 ? (uint8_t)(0xFF >> (17 - i)) : 0x00;
     }
-    if (millis_custom() - last_update >= 100) {
-        last_update = millis_custom();
-        if (step < 8) {
-            SET_BIT(leds, step);
-            PORTB = leds;
-            update_d7();
-            step++;
-        } else if (step == 8) {
-            step++;
-        } else if (step == 9) {
-            leds = 0;
-            PORTB = 0;
-            CLR_BIT(PORTC, LED_D7_PIN);
-            step = 0;
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                step = 10;
-                initialized = 0;
-            }
+};
+
+// ================================================================================
+// TABELA DE EXERCÍCIOS
+// ================================================================================
+#define ANIM_EX(passos, rep, saida)  { passos, sizeof(passos) / sizeof(passos[0]), rep, saida }
+
+const anim_desc_t ANIM_EX1  PROGMEM = ANIM_EX(PASSOS_EX1,  1, saida_teste);
+const anim_desc_t ANIM_EX2A PROGMEM = ANIM_EX(PASSOS_EX2A, 2, saida_bargraph);
+const anim_desc_t ANIM_EX2B PROGMEM = ANIM_EX(PASSOS_EX2B, 2, saida_bargraph);
+const anim_desc_t ANIM_EX2F PROGMEM = ANIM_EX(PASSOS_EX2F, 1, saida_bargraph);
+const anim_desc_t ANIM_EX2H PROGMEM = ANIM_EX(PASSOS_EX2H, 2, saida_bargraph);
+const anim_desc_t ANIM_EX2I PROGMEM = ANIM_EX(PASSOS_EX2I, 2, saida_bargraph);
+
+typedef struct {
+    const anim_desc_t *anim;    // Interpretador (0 → stream pela ISR)
+    const uint8_t *frames;      // Frames gerados em tempo de compilação
+    uint8_t n_frames;
+    uint8_t periodo_ms;
+    uint8_t voltas;             // Stream: repetições até o exercício acabar
+    uint8_t rastro;             // Stream desenhado pelo BAM (saida_rastro)
+} exercicio_t;
+
+#define EX_ANIM(desc)           { &desc, 0, 0, 0, 0, 0 }
+#define EX_STREAM(G, ms, rep)   { 0, anim_tabela<G>::frames, anim_tabela<G>::n, ms, rep, 0 }
+#define EX_RASTRO(G, ms, rep)   { 0, anim_tabela<G>::frames, anim_tabela<G>::n, ms, rep, 1 }
+
+const exercicio_t EXERCICIOS[10] PROGMEM = {
+    EX_ANIM(ANIM_EX1),                      // 1.1  - Piscar LED 3x rápido/devagar
+    EX_ANIM(ANIM_EX2A),                     // 1.2a - Direita→Esquerda mantendo
+    EX_ANIM(ANIM_EX2B),                     // 1.2b - Esquerda→Direita mantendo
+    EX_RASTRO(GeraUmPorVez, 75, 2),         // 1.2c - 1 LED por vez, com rastro
+    EX_RASTRO(GeraPingPong, 75, 2),         // 1.2d - Ping-pong, com rastro
+    EX_STREAM(GeraApagaUmPorVez, 75, 2),    // 1.2e - Apagar 1 por vez vai-volta
+    EX_ANIM(ANIM_EX2F),                     // 1.2f - Acender, piscar, apagar
+    EX_STREAM(GeraDireitaEsquerda, 100, 2), // 1.2g - D→E, apagar, E→D
+    EX_ANIM(ANIM_EX2H),                     // 1.2h - Contagem binária 0-255
+    EX_ANIM(ANIM_EX2I),                     // 1.2i - Contagem binária 255-0
+};
+
+// ================================================================================
+// SEQUENCIADOR (PLAYLIST)
+// ================================================================================
+// Cada exercício roda até completar suas repetições (tabela: 'repeticoes' do
+// descritor; stream: 'voltas') e avisa o sequenciador, que passa por estados
+// temporizados sem bloquear: o escalonador continua dormindo/rodando as
+// outras tarefas (telemetria, trace) durante a pausa.
+//
+//   TOCANDO ──fim──> PAUSA (saídas em 0, pinos em alta impedância)
+//      ^                 │ SEQ_PAUSA_MS
+//      └──── entra ──────┘ (PORT já em 0 antes do DDR: sem glitch)
+#define SEQ_PAUSA_MS    700
+
+#define SEQ_TOCANDO     0
+#define SEQ_PAUSA       1
+
+const uint8_t PLAYLIST[] PROGMEM = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+#define PLAYLIST_N      (sizeof(PLAYLIST) / sizeof(PLAYLIST[0]))
+
+static uint8_t seq_estado = SEQ_TOCANDO;
+static uint8_t seq_pos = 0;             // Posição na playlist
+uint8_t tarefa_troca = SCHED_NENHUMA;
+
+anim_t animacao;
+
+// Tarefa única para todos os exercícios (registrada com id == exercicio_atual,
+// assim as estatísticas do escalonador continuam separadas por exercício)
+void modulo1_animacao() {
+    if (sched_per_vencido(&animacao.per)) {
+        if (anim_no_fim(&animacao)) {
+            // Último frame já ficou o tempo dele: acabou (não recomeça)
+            sched_agora(tarefa_troca);
+            return;
         }
+        anim_avanca(&animacao);
     }
+    sched_next_at(animacao.per.proximo);
 }
 
-void modulo1_ex2b() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        step = 0;
-        leds = 0;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
+// Estado do exercício sempre do zero: animação, stream e saídas
+void inicia_exercicio() {
+    exercicio_t ex;
+    memcpy_P(&ex, &EXERCICIOS[exercicio_atual], sizeof(ex));
+    
+    anim_stream_para();
+    memset(&animacao, 0, sizeof(animacao));
+    animacao.per.politica = SCHED_PULA;
+    
+    // Timer2 parado e PORTB de volta à sombra; rastro: PORTB passa ao BAM
+    rastro_ativo = 0;
+    rastro_pendente = 0;
+    bam_para();
+    bargraph_pela_sombra(!ex.rastro);
+    SOMBRA_PORTB = 0x00;
+    SOMBRA_PORTC &= ~M1_PINOS_C;
+    sombra_commit();
+    if (ex.rastro) {
+        memset(brilho, 0, sizeof(brilho));
+        bam_inicia();
+        rastro_ativo = 1;
     }
-    if (millis_custom() - last_update >= 100) {
-        last_update = millis_custom();
-        if (step < 8) {
-            SET_BIT(leds, (7 - step));
-            PORTB = leds;
-            update_d7();
-            step++;
-        } else if (step == 8) {
-            step++;
-        } else if (step == 9) {
-            leds = 0;
-            PORTB = 0;
-            CLR_BIT(PORTC, LED_D7_PIN);
-            step = 0;
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                step = 10;
-                initialized = 0;
-            }
-        }
+    seq_estado = SEQ_TOCANDO;
+    
+    if (ex.anim) {
+        anim_inicia(&animacao, ex.anim);
+        sched_at(exercicio_atual, animacao.per.proximo);
+    } else {
+        // Sem tarefa no escalonador: os frames saem direto da ISR de 1ms
+        sched_stop(exercicio_atual);
+        anim_stream_inicia(ex.frames, ex.n_frames, ex.periodo_ms, ex.voltas);
     }
 }
 
-void modulo1_ex2c() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        position = 0;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (millis_custom() - last_update >= 75) {
-        last_update = millis_custom();
-        PORTB = 1 << position;
-        update_d7();
-        position++;
-        if (position >= 8) {
-            position = 0;
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                PORTB = 0;
-                CLR_BIT(PORTC, LED_D7_PIN);
-                initialized = 0;
-            }
+// Chamado dentro da ISR do Timer1 (1ms): frame do stream vai direto. No
+// rastro o brilho fica para o loop (modulo1_passo)
+void modulo1_tick() {
+    uint8_t frame;
+    if (anim_stream_tick(&frame)) {
+        if (rastro_ativo) {
+            rastro_frame = frame;
+            rastro_pendente = 1;
         }
+        saida_bargraph(frame);
+        sombra_commit();
     }
 }
 
-void modulo1_ex2d() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
-    static int8_t direction = 1;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        position = 0;
-        direction = 1;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (millis_custom() - last_update >= 75) {
-        last_update = millis_custom();
-        PORTB = 1 << position;
-        update_d7();
-        position += direction;
-        if (position >= 7 && direction > 0) {
-            direction = -1;
-        } else if (position <= 0 && direction < 0) {
-            direction = 1;
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                PORTB = 0;
-                CLR_BIT(PORTC, LED_D7_PIN);
-                initialized = 0;
-            }
-        }
-    }
+// Quadro de telemetria a cada TELEMETRIA_MS (lib/telemetria)
+static void envia_telemetria() {
+    telemetria_envia(exercicio_atual, 0);
+    sched_next(TELEMETRIA_MS);
 }
 
-void modulo1_ex2e() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
-    static int8_t direction = 1;
-    static uint8_t leds = 0xFF;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    static uint8_t show_all_time = 0;
-    if (!initialized) {
-        leds = 0xFF;
-        PORTB = 0xFF;
-        SET_BIT(PORTC, LED_D7_PIN);
-        position = 0;
-        direction = 1;
-        repeats = 0;
-        show_all_time = 150;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (millis_custom() - last_update >= 75) {
-        last_update = millis_custom();
-        if (show_all_time > 0) {
-            show_all_time -= 75;
-            PORTB = 0xFF;
-            SET_BIT(PORTC, LED_D7_PIN);
-        } else {
-            CLR_BIT(leds, position);
-            PORTB = leds;
-            update_d7();
-            if (direction > 0) {
-                if (position < 7) {
-                    position++;
-                } else {
-                    direction = -1;
-                    position--;
-                }
-            } else {
-                if (position > 0) {
-                    position--;
-                } else {
-                    direction = 1;
-                    leds = 0xFF;
-                    repeats++;
-                    show_all_time = 150;
-                    if (repeats >= 2) {
-                        repeats = 0;
-                        initialized = 0;
-                        PORTB = 0;
-                        CLR_BIT(PORTC, LED_D7_PIN);
-                    }
-                }
-            }
-        }
+// Acordada pelo fim do exercício (ou pelo fim da pausa)
+void troca_exercicio() {
+    if (seq_estado == SEQ_TOCANDO) {
+        // Para quem escreve em PORTB antes de mexer nos pinos
+        sched_stop(exercicio_atual);
+        anim_stream_para();
+        rastro_ativo = 0;
+        rastro_pendente = 0;
+        bam_para();                 // PORTB = 0, Timer2 parado
+        bargraph_pela_sombra(1);
+        
+        SOMBRA_PORTB = 0x00;
+        SOMBRA_PORTC &= ~M1_PINOS_C;
+        sombra_commit();
+        DDRB = 0x00;
+        DDRC &= ~M1_PINOS_C;
+        seq_estado = SEQ_PAUSA;
+        sched_next(SEQ_PAUSA_MS);
+        return;
     }
+    
+    // PORT em 0 desde a pausa: os pinos saem de alta impedância direto para 0
+    DDRB = 0xFF;
+    DDRC |= M1_PINOS_C;
+    
+    if (++seq_pos >= PLAYLIST_N) seq_pos = 0;
+    exercicio_atual = pgm_read_byte(&PLAYLIST[seq_pos]);
+    inicia_exercicio();
 }
 
-void modulo1_ex2f() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t blink_counter = 0;
-    static uint8_t leds = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        step = 0;
-        blink_counter = 0;
-        leds = 0;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (step < 8) {
-        if (millis_custom() - last_update >= 100) {
-            last_update = millis_custom();
-            SET_BIT(leds, step);
-            PORTB = leds;
-            update_d7();
-            step++;
-        }
-    } else if (step < 14) {
-        if (millis_custom() - last_update >= 150) {
-            last_update = millis_custom();
-            leds = (leds == 0xFF) ? 0x00 : 0xFF;
-            PORTB = leds;
-            update_d7();
-            blink_counter++;
-            if (blink_counter >= 4) {
-                step = 14;
-                blink_counter = 0;
-            } else {
-                step++;
-            }
-        }
-    } else {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        step = 0;
-        leds = 0;
-        initialized = 0;
+// Só mexe nos pinos do módulo: PORTB inteiro, PC0 (D7) e PC5 (LED teste)
+void modulo1_inicia(uint8_t ex) {
+    MCUCR |= (1 << PUD);
+    DDRB = 0xFF;
+    PORTB = 0x00;
+    DDRC |= M1_PINOS_C;
+    PORTC &= ~M1_PINOS_C;
+    bargraph_pela_sombra(1);
+    
+#ifndef FIRMWARE_UNICO
+    // No firmware único o setup() inicia os dois uma vez só: a troca não
+    // zera a fila da serial nem a fase do Timer1
+    timer1_init();
+    serial_init();
+#endif
+    
+    exercicio_atual = ex;
+    if (exercicio_atual > 9) exercicio_atual = 0;
+    seq_pos = 0;
+    for (uint8_t i = 0; i < PLAYLIST_N; i++) {
+        if (pgm_read_byte(&PLAYLIST[i]) == exercicio_atual) seq_pos = i;
     }
+    
+    // Tarefas 0-9 = exercícios (id == exercicio_atual), depois a troca
+    for (uint8_t i = 0; i < 10; i++) sched_add(modulo1_animacao);
+    tarefa_troca = sched_add(troca_exercicio);
+    sched_agora(sched_add(envia_telemetria));
+    
+    inicia_exercicio();
 }
 
-void modulo1_ex2g() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        step = 0;
-        leds = 0;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
+void modulo1_passo() {
+    // Frame novo do rastro (a ISR acorda o loop a cada ms)
+    if (rastro_pendente) {
+        uint8_t sreg = SREG;
+        cli();
+        uint8_t frame = rastro_frame;
+        rastro_pendente = 0;
+        SREG = sreg;
+        if (rastro_ativo) saida_rastro(frame);
     }
-    if (step < 8) {
-        if (millis_custom() - last_update >= 100) {
-            last_update = millis_custom();
-            SET_BIT(leds, (7 - step));  
-            PORTB = leds;
-            update_d7();
-            step++;
-        }
-    } 
-    else if (step == 8) {
-        if (millis_custom() - last_update >= 200) {
-            last_update = millis_custom();
-            leds = 0;
-            PORTB = 0;
-            CLR_BIT(PORTC, LED_D7_PIN);
-            step++;
-        }
-    } 
-    else if (step < 17) {
-        if (millis_custom() - last_update >= 100) {
-            last_update = millis_custom();
-            SET_BIT(leds, (step - 9));  
-            PORTB = leds;
-            update_d7();
-            step++;
-        }
-    } 
-    else {
-        leds = 0;
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        repeats++;
-        if (repeats >= 2) {
-            repeats = 0;
-            step = 100;
-            initialized = 0;
-        } else {
-            step = 0;
-        }
+    
+    // Stream terminou as voltas (sinalizado na ISR)
+    if (anim_stream_fim) {
+        anim_stream_fim = 0;
+        sched_agora(tarefa_troca);
     }
+    sched_run();
+    sombra_commit();
 }
 
-void modulo1_ex2h() {
-    static unsigned long last_update = 0;
-    static uint8_t counter = 0;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 0;
-        CLR_BIT(PORTC, LED_D7_PIN);
-        counter = 0;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
-        PORTB = counter;
-        update_d7();
-        counter++;
-        if (counter == 0) {
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                PORTB = 0;
-                CLR_BIT(PORTC, LED_D7_PIN);
-                initialized = 0;
-            }
-        }
-    }
+// O PUD desliga os pull-ups de todas as portas: devolve ao próximo módulo
+void modulo1_encerra() {
+    anim_stream_para();
+    rastro_ativo = 0;
+    rastro_pendente = 0;
+    bam_para();
+    sombra_para();
+    MCUCR &= ~(1 << PUD);
 }
 
-void modulo1_ex2i() {
-    static unsigned long last_update = 0;
-    static uint8_t counter = 255;
-    static uint8_t repeats = 0;
-    static uint8_t initialized = 0;
-    if (!initialized) {
-        PORTB = 255;
-        SET_BIT(PORTC, LED_D7_PIN);
-        counter = 255;
-        repeats = 0;
-        last_update = millis_custom();
-        initialized = 1;
-    }
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
-        PORTB = counter;
-        update_d7();
-        counter--;
-        if (counter == 255) {
-            repeats++;
-            if (repeats >= 2) {
-                repeats = 0;
-                initialized = 0;
-                PORTB = 0;
-                CLR_BIT(PORTC, LED_D7_PIN);
-            } else {
-                counter = 255;
-            }
-        }
-    }
+const modulo_t MODULO1 PROGMEM = {
+    modulo1_inicia, modulo1_passo, modulo1_encerra, modulo1_tick,
+    0, 10, { 0xFF, M1_PINOS_C, 0 }
+};
+
+// ================================================================================
+// BUILD SEPARADO (pio run -e modulo1)
+// ================================================================================
+#ifndef FIRMWARE_UNICO
+void timebase_tick_hook() {
+    modulo1_tick();
 }
 
 void setup() {
-    MCUCR |= (1 << PUD);
-    DDRB = 0xFF;
-    PORTB = 0x00;
-    DDRC = 0xFF;
-    PORTC = 0x00;
-    SET_BIT(DDRC, LED_TESTE_PIN);
-    CLR_BIT(PORTC, LED_TESTE_PIN);
-    SET_BIT(DDRC, LED_D7_PIN);
-    CLR_BIT(PORTC, LED_D7_PIN);
-    
-    timer1_init();
-    
     // ═══════════════════════════════════════════════════════════════════
     // ⚙️ CONFIGURE AQUI O EXERCÍCIO QUE DESEJA EXECUTAR (0 a 9):
     // ═══════════════════════════════════════════════════════════════════
-    exercicio_atual = 0;  // ← MUDE ESTE NÚMERO
+    modulo1_inicia(0);  // ← MUDE ESTE NÚMERO
     // ═══════════════════════════════════════════════════════════════════
-    
-    exercise_start_time = millis_custom();
 }
 
 void loop() {
-    if (millis_custom() - exercise_start_time >= exercise_duration) {
-        PORTB = 0x00;
-        PORTC = 0x00;
-        DDRB = 0x00;
-        DDRC = 0x00;
-        delay_ms(700);
-        DDRB = 0xFF;
-        DDRC = 0xFF;
-        PORTB = 0x00;
-        PORTC = 0x00;
-        
-        exercicio_atual++;
-        if (exercicio_atual > 9) exercicio_atual = 0;
-        exercise_start_time = millis_custom();
-    }
-    
-    switch (exercicio_atual) {
-        case 0:  modulo1_ex1();   break;
-        case 1:  modulo1_ex2a();  break;
-        case 2:  modulo1_ex2b();  break;
-        case 3:  modulo1_ex2c();  break;
-        case 4:  modulo1_ex2d();  break;
-        case 5:  modulo1_ex2e();  break;
-        case 6:  modulo1_ex2f();  break;
-        case 7:  modulo1_ex2g();  break;
-        case 8:  modulo1_ex2h();  break;
-        case 9:  modulo1_ex2i();  break;
-        default: modulo1_ex1();   break;
-    }
+    trace_comando();
+    modulo1_passo();
 }
+#endif
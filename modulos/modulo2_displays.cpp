@@ -8,7 +8,9 @@
  * Controle de 2 displays de 7 segmentos multiplexados (cátodo comum)
  * - Display 1 (esquerdo): Contagem crescente 0→F (hexadecimal)
  * - Display 2 (direito): Contagem decrescente F→0 (hexadecimal)
- * - Multiplexação ultra-rápida: 200µs por display (SEM piscamento!)
+ * - Multiplexação por interrupção (Timer2 CTC): a ISR varre o framebuffer
+ *   'display_fb[]' com um intervalo apagado (blanking) entre os dígitos
+ * - O loop principal só escreve no framebuffer e dorme (SLEEP_MODE_IDLE)
  * - Atualização: ~200ms entre mudanças de número
  * 
  * CONEXÕES DE HARDWARE (ATmega328P):
@@ -22,77 +24,181 @@
  */
 
 #include <avr/io.h>
-#include <util/delay.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+#include "modulo.h"
+#include "seg7.h"
 
 // ================================================================================
-// TABELA DE CONVERSÃO HEXADECIMAL → 7 SEGMENTOS (CÁTODO COMUM)
+// CONFIGURAÇÃO DA MULTIPLEXAÇÃO (Timer2)
 // ================================================================================
-// Formato: 0bGFEDCBA (7 bits = 7 segmentos)
-const uint8_t hexa[16] = {
-    0b00111111,  // 0: A B C D E F
-    0b00000110,  // 1: B C
-    0b01011011,  // 2: A B D E G
-    0b01001111,  // 3: A B C D G
-    0b01100110,  // 4: B C F G
-    0b01101101,  // 5: A C D F G
-    0b01111101,  // 6: A C D E F G
-    0b00000111,  // 7: A B C
-    0b01111111,  // 8: A B C D E F G (todos)
-    0b01101111,  // 9: A B C D F G
-    0b01110111,  // A: A B C E F G
-    0b01111100,  // b: C D E F G
-    0b00111001,  // C: A D E F
-    0b01011110,  // d: B C D E G
-    0b01111001,  // E: A D E F G
-    0b01110001   // F: A E F G
+#define MUX_NUM_DIGITOS     2
+#define MUX_REFRESH_HZ      250     // Varreduras completas por segundo
+#define MUX_BLANK_US        32      // Tempo apagado entre dígitos (anti-ghosting)
+#define MUX_ATUALIZA_MS     200     // Intervalo entre mudanças de número
+
+// Timer2 com prescaler 256 → 1 tick = 16µs @ 16MHz
+#define MUX_PRESCALER       256UL
+#define MUX_TICK_US         (MUX_PRESCALER * 1000000UL / F_CPU)
+#define MUX_TICKS_DIGITO    (F_CPU / MUX_PRESCALER / (MUX_REFRESH_HZ * MUX_NUM_DIGITOS))
+#define MUX_TICKS_BLANK     ((MUX_BLANK_US + MUX_TICK_US - 1) / MUX_TICK_US)
+#define MUX_OCR_ACESO       (MUX_TICKS_DIGITO - MUX_TICKS_BLANK - 1)
+#define MUX_OCR_BLANK       (MUX_TICKS_BLANK - 1)
+#define MUX_QUADROS_ATUALIZA ((MUX_REFRESH_HZ * MUX_ATUALIZA_MS) / 1000)
+
+static_assert(MUX_TICKS_DIGITO <= 256, "MUX_REFRESH_HZ baixo demais para o Timer2");
+static_assert(MUX_TICKS_BLANK >= 1 && MUX_OCR_ACESO >= 1, "MUX_BLANK_US incompatível com MUX_REFRESH_HZ");
+static_assert(MUX_QUADROS_ATUALIZA >= 1 && MUX_QUADROS_ATUALIZA <= 255, "MUX_ATUALIZA_MS fora da faixa");
+
+#define MUX_SEL_MASK        ((1 << PC0) | (1 << PC1))
+
+// ================================================================================
+// TABELA DE GLIFOS → 7 SEGMENTOS (CÁTODO COMUM, lib/seg7)
+// ================================================================================
+// Formato: 0bGFEDCBA (7 bits = 7 segmentos). Em RAM: a ISR lê com LD
+const uint8_t hexa[SEG7_N] = { SEG7_PADROES(SEG7_BYTE) };
+
+// Linha de seleção (PORTC) de cada dígito
+const uint8_t mux_sel[MUX_NUM_DIGITOS] = {
+    (1 << PC0),  // Display 1
+    (1 << PC1)   // Display 2
 };
 
 // ================================================================================
-// FUNÇÃO MAIN
+// FRAMEBUFFER - 1 byte por dígito (código de glifo, índice em hexa[])
 // ================================================================================
-int main(void) {
+volatile uint8_t display_fb[MUX_NUM_DIGITOS] = {0, 0};
+volatile uint8_t mux_quadros = 0;  // Incrementa a cada varredura completa
+
+// ================================================================================
+// TIMER2 - MULTIPLEXAÇÃO
+// ================================================================================
+void mux_init() {
+    cli();
+    TCCR2A = (1 << WGM21);                 // Modo CTC
+    TCCR2B = (1 << CS22) | (1 << CS21);    // Prescaler 256
+    TCNT2 = 0;
+    OCR2A = MUX_OCR_BLANK;                 // Começa apagado
+    TIMSK2 = (1 << OCIE2A);
+    sei();
+}
+
+// Cada dígito ocupa duas fases: aceso (MUX_OCR_ACESO) e apagado (MUX_OCR_BLANK).
+// Os segmentos só mudam com todos os dígitos desligados, evitando "fantasmas".
+ISR(TIMER2_COMPA_vect) {
+    static uint8_t digito = MUX_NUM_DIGITOS - 1;
+    static uint8_t aceso = 0;
+    
+    if (aceso) {
+        // Fim do tempo aceso → blanking
+        PORTC &= ~MUX_SEL_MASK;
+        OCR2A = MUX_OCR_BLANK;
+        aceso = 0;
+        return;
+    }
+    
+    // Fim do blanking → próximo dígito
+    digito++;
+    if (digito >= MUX_NUM_DIGITOS) {
+        digito = 0;
+        mux_quadros++;
+    }
+    PORTB = hexa[display_fb[digito]];
+    PORTC = (PORTC & ~MUX_SEL_MASK) | mux_sel[digito];
+    OCR2A = MUX_OCR_ACESO;
+    aceso = 1;
+}
+
+// ================================================================================
+// CONTAGEM (loop principal)
+// ================================================================================
+static uint8_t contador_crescente = 0;      // Display 1: 0→F
+static uint8_t contador_decrescente = 15;   // Display 2: F→0
+static uint8_t ultimo_quadro = 0;
+
+// Um dígito hexa por display. Cada byte do framebuffer é escrito de uma
+// vez (a ISR nunca vê meio glifo)
+static void publica() {
+    uint8_t g[MUX_NUM_DIGITOS];
+    seg7_u8(&g[0], 1, contador_crescente, SEG7_HEX);
+    seg7_u8(&g[1], 1, contador_decrescente, SEG7_HEX);
+    display_fb[0] = g[0];
+    display_fb[1] = g[1];
+}
+
+void modulo2_inicia(uint8_t) {
     // Configura PORTB como saída (segmentos A-G)
     DDRB = 0b01111111;  // PB0-PB6 como saída
     PORTB = 0x00;      // Inicialmente apagado
     
     // Configura PORTC como saída (seleção de displays)
-    DDRC = (1 << PC0) | (1 << PC1);  // PC0 e PC1 como saída
-    PORTC = 0x00;                     // Inicialmente apagado
+    DDRC |= MUX_SEL_MASK;       // PC0 e PC1 como saída
+    PORTC &= ~MUX_SEL_MASK;     // Inicialmente apagado
     
-    // Contadores
-    uint8_t contador_crescente = 0;   // Display 1: 0→F
-    uint8_t contador_decrescente = 15; // Display 2: F→0
+    contador_crescente = 0;
+    contador_decrescente = 15;
+    publica();
+    
+    mux_init();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    ultimo_quadro = mux_quadros;
+}
+
+// Uma volta do loop: dorme até a próxima interrupção ou, passados ~200ms,
+// avança os contadores e publica no framebuffer
+void modulo2_passo() {
+    // ========== ESPERA ~200ms DORMINDO ==========
+    // A CPU só acorda nas interrupções (refresh feito na ISR do Timer2)
+    if ((uint8_t)(mux_quadros - ultimo_quadro) < MUX_QUADROS_ATUALIZA) {
+        sleep_mode();
+        return;
+    }
+    ultimo_quadro += MUX_QUADROS_ATUALIZA;
+    
+    // ========== ATUALIZA CONTADORES ==========
+    // Incrementa Display 1 (0→F→0)
+    contador_crescente++;
+    if (contador_crescente > 15) {
+        contador_crescente = 0;
+    }
+    
+    // Decrementa Display 2 (F→0→F)
+    if (contador_decrescente == 0) {
+        contador_decrescente = 15;
+    } else {
+        contador_decrescente--;
+    }
+    
+    // ========== PUBLICA NO FRAMEBUFFER ==========
+    publica();
+}
+
+// Para o Timer2 e apaga os dígitos
+void modulo2_encerra() {
+    TIMSK2 = 0;
+    TCCR2B = 0;
+    TIFR2 = (1 << OCF2A);
+    PORTC &= ~MUX_SEL_MASK;
+}
+
+const modulo_t MODULO2 PROGMEM = {
+    modulo2_inicia, modulo2_passo, modulo2_encerra, 0,
+    0, 1, { 0b01111111, MUX_SEL_MASK, 0 }
+};
+
+// ================================================================================
+// FUNÇÃO MAIN (build separado: pio run -e modulo2)
+// ================================================================================
+#ifndef FIRMWARE_UNICO
+int main(void) {
+    modulo2_inicia(0);
     
     // Loop infinito
     while (1) {
-        // Multiplexação ULTRA-RÁPIDA: 500 ciclos × 0.4ms = ~200ms por número
-        for (uint16_t i = 0; i < 500; i++) {
-            
-            // ========== DISPLAY 1 (Esquerdo) ==========
-            PORTB = hexa[contador_crescente];  // Carrega padrão
-            PORTC = (1 << PC0);                // Ativa Display 1
-            _delay_us(200);                    // 0.2ms (ultra-rápido, sem piscamento!)
-            
-            // ========== DISPLAY 2 (Direito) ==========
-            PORTB = hexa[contador_decrescente]; // Carrega padrão
-            PORTC = (1 << PC1);                 // Ativa Display 2
-            _delay_us(200);                     // 0.2ms (ultra-rápido, sem piscamento!)
-        }
-        
-        // ========== ATUALIZA CONTADORES ==========
-        // Incrementa Display 1 (0→F→0)
-        contador_crescente++;
-        if (contador_crescente > 15) {
-            contador_crescente = 0;
-        }
-        
-        // Decrementa Display 2 (F→0→F)
-        if (contador_decrescente == 0) {
-            contador_decrescente = 15;
-        } else {
-            contador_decrescente--;
-        }
+        modulo2_passo();
     }
     
     return 0;
 }
+#endif
@@ -12,345 +12,443 @@
  * - LED2: PD4 (pino 2) → 220Ω → GND
  * - LED3: PB0 (pino 12) → 220Ω → GND
  * - LED4: PB1 (pino 13) → 220Ω → GND
+ * Os pisca-piscas são do lib/led: LED1 (PD3 = OC2B) troca pelo hardware do
+ * Timer2; LED2 e LED3 (sem OC) trocam na ISR de 1ms
+ * Build separado: sem LED piscando nem deadline pendente (3.1, 3.6, 3.9
+ * parados...) o chip dorme em POWER_DOWN e só a PCINT1 dos botões acorda
  * 
  * SELECIONE O EXERCÍCIO: exercicio_atual = 1-10
  * ================================================================================
  */
 
-#include <Arduino.h>
+#include "boot.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "timebase.h"
+#include "scheduler.h"
+#include "botoes.h"
+#include "trace.h"
+#include "serial.h"
+#include "telemetria.h"
+#include "modulo.h"
+#include "arena.h"
+#include "led.h"
+#include "seg7.h"
+#include "sombra.h"
+#include "pino.h"
+#include "energia.h"
+#include "acorde.h"
 
 // ================================================================================
-// MACROS
+// DEFINIÇÃO DE PINOS
 // ================================================================================
-#define SET_BIT(REG, BIT)    (REG |= (1 << BIT))
-#define CLR_BIT(REG, BIT)    (REG &= ~(1 << BIT))
-#define TGL_BIT(REG, BIT)    (REG ^= (1 << BIT))
-#define READ_BIT(REG, BIT)   ((REG >> BIT) & 1)
+// Botões (entrada com pull-up, lidos por lib/botoes)
+typedef Pin<PortC, PC2> Btn1;
+typedef Pin<PortC, PC3> Btn2;
+typedef Pin<PortC, PC4> Btn3;
+typedef PinGroup<Btn1, Btn2, Btn3> Botoes;
+
+// Número do botão nos eventos de lib/botoes (bit de PORTC)
+#define BTN1    Btn1::bit
+#define BTN2    Btn2::bit
+#define BTN3    Btn3::bit
+
+// LEDs: a lógica escreve nas cópias (lib/sombra), o passo faz o commit
+typedef Pin<Sombra<PortD>, PD3> Led1;
+typedef Pin<Sombra<PortD>, PD4> Led2;
+typedef Pin<Sombra<PortB>, PB0> Led3;
+typedef Pin<Sombra<PortB>, PB1> Led4;
+typedef PinGroup<Led1, Led2, Led3> Leds123;         // Sequências 1-2-3
+typedef PinGroup<Led1, Led2, Led3, Led4> Leds;
+
+// Os mesmos pinos para lib/led
+#define LED1_PINO   Led1::id
+#define LED2_PINO   Led2::id
+#define LED3_PINO   Led3::id
+
+// Display 7 Segmentos (cátodo comum), na ordem dos bits do padrão (A-G)
+typedef Pin<Sombra<PortC>, PC0> SegA;   // Pino 23
+typedef Pin<Sombra<PortC>, PC1> SegB;   // Pino 24
+typedef Pin<Sombra<PortC>, PC5> SegC;   // Pino 28
+typedef Pin<Sombra<PortD>, PD5> SegD;   // Pino 9
+typedef Pin<Sombra<PortD>, PD6> SegE;   // Pino 10
+typedef Pin<Sombra<PortD>, PD7> SegF;   // Pino 11
+typedef Pin<Sombra<PortB>, PB2> SegG;   // Pino 14
+typedef PinGroup<SegA, SegB, SegC, SegD, SegE, SegF, SegG> Segmentos;
+
+// Todos os pinos do módulo: um bit usado duas vezes não compila
+typedef PinGroup<Btn1, Btn2, Btn3, Led1, Led2, Led3, Led4,
+                 SegA, SegB, SegC, SegD, SegE, SegF, SegG> PinosM3;
+static_assert((PinosM3::mascara<PortD>() & 0x03) == 0, "PD0/PD1 são da serial");
 
 // ================================================================================
-// DEFINIÇÃO DE PINOS
+// VARIÁVEIS GLOBAIS
+// ================================================================================
+static uint8_t exercicio_atual = 2;  // Ex 3.2 para testar
+
+// Estado dos botões reconstruído pelos eventos PRESS/RELEASE (bits de PORTC)
+uint8_t btn_estado = 0;
+
+// ================================================================================
+// ESTADO DOS EXERCÍCIOS (lib/arena)
 // ================================================================================
-// Botões
-#define BTN1    PC2
-#define BTN2    PC3
-#define BTN3    PC4
+// Um exercício por vez: os estados dividem a mesma RAM (union 'ex')
+typedef struct {
+    uint8_t ligado;
+} ex31_t;
+
+typedef struct {
+    sched_per_t passo;
+    uint8_t running;            // Controla se sequência está rodando
+    uint8_t direction;          // 0 = 1-2-3, 1 = 3-2-1
+    uint8_t index;              // 0, 1 ou 2
+} ex33_t;
+
+typedef struct {
+    sched_per_t reduz;
+    uint16_t interval;          // Começa em 500ms
+} ex34_t;
+
+typedef struct {
+    uint8_t freq_level;         // 0-5 (0 = apagado, 5 = aceso fixo)
+} ex35_t;
+
+typedef struct {
+    acorde_t acorde;
+} ex36_t;
+
+typedef struct {
+    acorde_t acorde;
+    uint8_t modo;               // 2 = inativo, 0 = modo botão 1, 1 = modo botão 2
+} ex37_t;
+
+typedef struct {
+    acorde_t acorde;
+    sched_per_t passo;
+    uint8_t index;
+    uint8_t parado;             // Sem botão (ou os dois) desde o último passo
+} ex38_t;
 
-// LEDs
-#define LED1    PD3
-#define LED2    PD4
-#define LED3    PB0
-#define LED4    PB1
+typedef struct {
+    acorde_t acorde;
+} ex39_t;
 
-// Display 7 Segmentos (cátodo comum)
-#define SEG_A   PC0  // Pino 23
-#define SEG_B   PC1  // Pino 24
-#define SEG_C   PC5  // Pino 28
-#define SEG_D   PD5  // Pino 9
-#define SEG_E   PD6  // Pino 10
-#define SEG_F   PD7  // Pino 11
-#define SEG_G   PB2  // Pino 14
+typedef struct {
+    uint8_t modo;               // 0 = nenhum, 1/2/3 = modos
+} ex310_t;
+
+static union {
+    ex31_t ex31;
+    ex33_t ex33;
+    ex34_t ex34;
+    ex35_t ex35;
+    ex36_t ex36;
+    ex37_t ex37;
+    ex38_t ex38;
+    ex39_t ex39;
+    ex310_t ex310;
+} ex;
+
+ARENA_RELATA(m3_ex3_1, ex31_t)
+ARENA_RELATA(m3_ex3_3, ex33_t)
+ARENA_RELATA(m3_ex3_4, ex34_t)
+ARENA_RELATA(m3_ex3_5, ex35_t)
+ARENA_RELATA(m3_ex3_6, ex36_t)
+ARENA_RELATA(m3_ex3_7, ex37_t)
+ARENA_RELATA(m3_ex3_8, ex38_t)
+ARENA_RELATA(m3_ex3_9, ex39_t)
+ARENA_RELATA(m3_ex3_10, ex310_t)
+
+static uint8_t ex_na_arena = 0;     // Exercício dono do estado atual
 
 // ================================================================================
-// VARIÁVEIS GLOBAIS
+// COMBINAÇÕES DE BOTÕES (lib/acorde) - EXERCÍCIOS 3.6 A 3.9
 // ================================================================================
-volatile unsigned long timer_millis = 0;
-uint8_t exercicio_atual = 2;  // Ex 3.2 para testar
+// Bordas a até M3_JANELA_ACORDE_MS da primeira contam como pressionadas
+// juntas; a tabela diz o que cada conjunto faz
+#define M3_JANELA_ACORDE_MS     40
 
-// Debounce melhorado
-uint8_t btn_last[3] = {0, 0, 0};
-uint8_t btn_click[3] = {0, 0, 0};
-unsigned long btn_last_time[3] = {0, 0, 0};  // Timestamp de última mudança
+// Ação = nível do LED1
+const acorde_entrada_t ACORDES_3_6[] PROGMEM = {
+    { 0,                              0 },
+    { Btn1::mascara,                  1 },            // Qualquer um = acende
+    { Btn2::mascara,                  1 },
+    { Btn1::mascara | Btn2::mascara,  0 },            // Ambos = apaga
+};
 
-// Ex 3.1
-uint8_t ex31_state = 0;
+enum { M37_MANTEM, M37_MODO1, M37_MODO2, M37_APAGA };
+const acorde_entrada_t ACORDES_3_7[] PROGMEM = {
+    { 0,                              M37_MANTEM },
+    { Btn1::mascara,                  M37_MODO1 },
+    { Btn2::mascara,                  M37_MODO2 },
+    { Btn1::mascara | Btn2::mascara,  M37_APAGA },
+};
 
-// Ex 3.2
-uint8_t ex32_mode = 0;
+enum { M38_PARA, M38_SOBE, M38_DESCE };
+const acorde_entrada_t ACORDES_3_8[] PROGMEM = {
+    { 0,                              M38_PARA },
+    { Btn1::mascara,                  M38_SOBE },     // 1-2-3
+    { Btn2::mascara,                  M38_DESCE },    // 3-2-1
+    { Btn1::mascara | Btn2::mascara,  M38_PARA },
+};
 
-// Ex 3.3
-uint8_t ex33_running = 0;  // Controla se sequência está rodando
+// Ação = LED4..LED1 (Leds::write). A ordem desempata: BTN1 + BTN2 acende
+// todos, BTN2 + BTN3 só LED1 e LED2 (como os if/else de antes)
+const acorde_entrada_t ACORDES_3_9[] PROGMEM = {
+    { 0,                              0b0000 },
+    { Btn1::mascara | Btn3::mascara,  0b0000 },
+    { Btn1::mascara,                  0b1111 },
+    { Btn2::mascara,                  0b0011 },
+    { Btn3::mascara,                  0b1100 },
+};
 
-// Ex 3.4
-uint8_t ex34_btn_state = 0;
+#define ACORDE_INICIA(a, tabela) \
+    acorde_inicia(&(a), tabela, sizeof(tabela) / sizeof(tabela[0]), \
+                  Botoes::mascara<PortC>(), M3_JANELA_ACORDE_MS)
 
-// Ex 3.5
-uint8_t ex35_freq_level = 0;
+// Zera a arena, para os pisca-piscas do exercício anterior e põe os
+// valores iniciais do exercício n (1-10). Os temporizadores que dependem
+// de botão são armados no evento (3.3, 3.4); as sequências saem em rajada
+// (sched_per_t). Pisca-pisca é do lib/led, fora do escalonador
+static void entra_exercicio(uint8_t n) {
+    ARENA_ZERA(ex);
+    ex_na_arena = n;
+    led_para();
+    sombra_sincroniza();    // led_para() escreveu direto nas portas
+    switch (n) {
+        case 2: led_blink(LED1_PINO, 400); break;
+        case 4: ex.ex34.interval = 500; break;
+        case 6: ACORDE_INICIA(ex.ex36.acorde, ACORDES_3_6); break;
+        case 7:
+            ACORDE_INICIA(ex.ex37.acorde, ACORDES_3_7);
+            ex.ex37.modo = 2;
+            break;
+        case 8:
+            ACORDE_INICIA(ex.ex38.acorde, ACORDES_3_8);
+            sched_per_inicia(&ex.ex38.passo, 150, SCHED_RAJADA);
+            ex.ex38.parado = 1;
+            break;
+        case 9: ACORDE_INICIA(ex.ex39.acorde, ACORDES_3_9); break;
+    }
+}
 
 // ================================================================================
 // TABELA DE DÍGITOS - DISPLAY 7 SEGMENTOS
 // ================================================================================
-// Padrão para cada dígito (bits: GFEDCBA)
+// Padrão de cada glifo de lib/seg7 (bits: GFEDCBA)
 // Bit 0=A, Bit 1=B, Bit 2=C, Bit 3=D, Bit 4=E, Bit 5=F, Bit 6=G
-const uint8_t DIGIT_7SEG[10] = {
-    0b00111111,  // 0: A B C D E F
-    0b00000110,  // 1: B C
-    0b01011011,  // 2: A B D E G
-    0b01001111,  // 3: A B C D G
-    0b01100110,  // 4: B C F G
-    0b01101101,  // 5: A C D F G
-    0b01111101,  // 6: A C D E F G
-    0b00000111,  // 7: A B C
-    0b01111111,  // 8: A B C D E F G
-    0b01101111   // 9: A B C D F G
-};
+// Segmentos::espalha() leva cada padrão para os bits de PORTC/PORTD/PORTB
+// dos segmentos: atualizar um dígito = 1 escrita mascarada por porta.
+#define SEG_MASK_C  Segmentos::mascara<PortC>()
+#define SEG_MASK_D  Segmentos::mascara<PortD>()
+#define SEG_MASK_B  Segmentos::mascara<PortB>()
+
+typedef struct {
+    uint8_t c;  // Valor para os bits SEG_MASK_C de PORTC
+    uint8_t d;  // Valor para os bits SEG_MASK_D de PORTD
+    uint8_t b;  // Valor para os bits SEG_MASK_B de PORTB
+} seg7_portas_t;
+
+#define SEG7_PORTAS(p)  { Segmentos::espalha<PortC>(p), Segmentos::espalha<PortD>(p), Segmentos::espalha<PortB>(p) },
+
+// Um trio de bytes por glifo de lib/seg7 (dígitos 0-F, apagado, -, estouro)
+const seg7_portas_t DIGIT_7SEG[SEG7_N] PROGMEM = { SEG7_PADROES(SEG7_PORTAS) };
 
 // ================================================================================
-// TIMER1 - 1ms
+// LEITURA DE BOTÕES - DEBOUNCE NA ISR DE 1ms (lib/botoes)
 // ================================================================================
-ISR(TIMER1_COMPA_vect) {
-    timer_millis++;
+#define BTN_MASK    Botoes::mascara<PortC>()
+
+// Próximo evento da fila (mantém btn_estado em dia)
+static uint8_t proximo_evento(botoes_evento_t *ev) {
+    if (!botoes_evento(ev)) return 0;
+    if (ev->tipo == EVT_PRESS) btn_estado |= (1 << ev->botao);
+    else if (ev->tipo == EVT_RELEASE) btn_estado &= ~(1 << ev->botao);
+    return 1;
 }
 
-void timer1_init() {
-    cli();
-    TCCR1A = 0;
-    TCCR1B = 0;
-    TCNT1 = 0;
-    OCR1A = 249;
-    SET_BIT(TCCR1B, WGM12);
-    SET_BIT(TCCR1B, CS11);
-    SET_BIT(TCCR1B, CS10);
-    SET_BIT(TIMSK1, OCIE1A);
-    sei();
+// Para exercícios que só olham o estado: esvazia a fila
+static void descarta_eventos() {
+    botoes_evento_t ev;
+    while (proximo_evento(&ev));
 }
 
-unsigned long millis_custom() {
-    unsigned long m;
-    cli();
-    m = timer_millis;
-    sei();
-    return m;
+static inline uint8_t eh(const botoes_evento_t *ev, uint8_t tipo, uint8_t btn) {
+    return ev->tipo == tipo && ev->botao == btn;
 }
 
-// ================================================================================
-// LEITURA DE BOTÕES - COM DEBOUNCE POR TEMPO
-// ================================================================================
-void ler_botoes() {
-    uint8_t btn_pins[3] = {BTN1, BTN2, BTN3};
-    unsigned long now = millis_custom();
-    
-    for (uint8_t i = 0; i < 3; i++) {
-        // Leitura direta: 1 = solto (pull-up), 0 = pressionado
-        uint8_t reading = READ_BIT(PINC, btn_pins[i]);
-        
-        // Detecta borda de descida (1→0 = pressionado)
-        if (reading == 0 && btn_last[i] == 1) {
-            // Debounce: só aceita se passou 50ms desde última mudança
-            if ((now - btn_last_time[i]) > 50) {
-                btn_click[i] = 1;  // Marca clique
-                btn_last_time[i] = now;
-            }
+// PRESS/RELEASE → acorde; com a janela aberta, a tarefa volta no prazo.
+// 1 = o conjunto de botões que vale mudou
+static uint8_t atualiza_acorde(acorde_t *a) {
+    uint8_t mudou = 0;
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (ev.tipo == EVT_PRESS || ev.tipo == EVT_RELEASE) {
+            mudou |= acorde_muda(a, btn_estado, ev.t);
         }
-        
-        // Atualiza tempo se houve mudança
-        if (reading != btn_last[i]) {
-            btn_last_time[i] = now;
-        }
-        
-        btn_last[i] = reading;
     }
+    mudou |= acorde_vence(a, tick16());
+    if (acorde_pendente(a)) sched_next_at(acorde_prazo(a));
+    return mudou;
+}
+
+// 1 = pressionado (segundo os eventos já consumidos)
+static inline uint8_t pressionado(uint8_t btn) {
+    return (btn_estado >> btn) & 1;
 }
 
 // ================================================================================
 // FUNÇÃO AUXILIAR - ATUALIZA DISPLAY 7 SEGMENTOS
 // ================================================================================
-void atualizar_display(uint8_t digito) {
-    if (digito > 9) digito = 0;  // Limita a 0-9
-    
-    uint8_t pattern = DIGIT_7SEG[digito];
-    
-    // Atualiza cada segmento individualmente
-    if (pattern & (1 << 0)) SET_BIT(PORTC, SEG_A); else CLR_BIT(PORTC, SEG_A);
-    if (pattern & (1 << 1)) SET_BIT(PORTC, SEG_B); else CLR_BIT(PORTC, SEG_B);
-    if (pattern & (1 << 2)) SET_BIT(PORTC, SEG_C); else CLR_BIT(PORTC, SEG_C);
-    if (pattern & (1 << 3)) SET_BIT(PORTD, SEG_D); else CLR_BIT(PORTD, SEG_D);
-    if (pattern & (1 << 4)) SET_BIT(PORTD, SEG_E); else CLR_BIT(PORTD, SEG_E);
-    if (pattern & (1 << 5)) SET_BIT(PORTD, SEG_F); else CLR_BIT(PORTD, SEG_F);
-    if (pattern & (1 << 6)) SET_BIT(PORTB, SEG_G); else CLR_BIT(PORTB, SEG_G);
+static uint8_t display_ultimo = 0xFF;  // 0xFF força a próxima escrita
+
+// Um dígito decimal; fora de 0-9 mostra o glifo de estouro (‾ ou _)
+void atualizar_display(int16_t valor) {
+    uint8_t glifo;
+    seg7_s16(&glifo, 1, valor, SEG7_DEC);
+    if (glifo == display_ultimo) return;  // Nada mudou: não toca nas portas
+    display_ultimo = glifo;
+    
+    // Os três bytes vão para as cópias; o commit do passo escreve as
+    // três portas juntas (sem estados intermediários visíveis)
+    const seg7_portas_t *g = &DIGIT_7SEG[glifo];
+    SOMBRA_PORTC = (SOMBRA_PORTC & ~SEG_MASK_C) | pgm_read_byte(&g->c);
+    SOMBRA_PORTD = (SOMBRA_PORTD & ~SEG_MASK_D) | pgm_read_byte(&g->d);
+    SOMBRA_PORTB = (SOMBRA_PORTB & ~SEG_MASK_B) | pgm_read_byte(&g->b);
 }
 
 // ================================================================================
 // EXERCÍCIO 3.1 - TOGGLE LED
 // ================================================================================
 void ex3_1() {
-    if (btn_click[0]) {
-        btn_click[0] = 0;
-        ex31_state = !ex31_state;
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (eh(&ev, EVT_PRESS, BTN1)) ex.ex31.ligado = !ex.ex31.ligado;
     }
     
-    if (ex31_state) {
-        SET_BIT(PORTD, LED1);
-    } else {
-        CLR_BIT(PORTD, LED1);
-    }
+    Led1::write(ex.ex31.ligado);
 }
 
 // ================================================================================
 // EXERCÍCIO 3.2 - LED PISCA RAPIDAMENTE
 // ================================================================================
+// LED1 troca a cada 200ms pelo OC2B (armado em entra_exercicio): a tarefa
+// só esvazia a fila
 void ex3_2() {
-    static unsigned long last_blink = 0;
-    
-    // Pisca LED1 a cada 200ms (rápido)
-    if (millis_custom() - last_blink >= 200) {
-        last_blink = millis_custom();
-        TGL_BIT(PORTD, LED1);  // Alterna entre ON e OFF
-    }
+    descarta_eventos();
 }
 
 // ================================================================================
 // EXERCÍCIO 3.3 - SEQUÊNCIA 1-2-3 / 3-2-1 (COMEÇA COM BOTÃO)
 // ================================================================================
 void ex3_3() {
-    static uint8_t direction = 0;  // 0 = 1-2-3, 1 = 3-2-1
-    static uint8_t index = 0;      // 0, 1 ou 2
-    static unsigned long last_update = 0;
+    ex33_t &s = ex.ex33;
     
     // Clique BTN1 = inicia ou inverte
-    if (btn_click[0]) {
-        btn_click[0] = 0;
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (!eh(&ev, EVT_PRESS, BTN1)) continue;
         
-        if (ex33_running == 0) {
+        if (s.running == 0) {
             // Começa a sequência
-            ex33_running = 1;
-            direction = 0;
-            index = 0;
-            last_update = millis_custom();
+            s.running = 1;
+            s.direction = 0;
+            s.index = 0;
+            sched_per_inicia(&s.passo, 150, SCHED_RAJADA);
         } else {
             // Inverte direção
-            direction = !direction;
-            index = 0;
-            last_update = millis_custom();
+            s.direction = !s.direction;
+            s.index = 0;
+            sched_per_inicia(&s.passo, 150, SCHED_RAJADA);
         }
     }
     
     // Só executa se estiver rodando
-    if (ex33_running == 0) {
+    if (s.running == 0) {
         // Apaga todos os LEDs
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
+        Leds123::clr();
         return;
     }
     
     // Avança sequência a cada 150ms (bem rápido)
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
-        index++;
-        if (index >= 3) index = 0;
+    if (sched_per_venceu(&s.passo)) {
+        s.index++;
+        if (s.index >= 3) s.index = 0;
     }
     
-    // Apaga todos os LEDs primeiro
-    CLR_BIT(PORTD, LED1);
-    CLR_BIT(PORTD, LED2);
-    CLR_BIT(PORTB, LED3);
+    // Só o LED do passo aceso: 1-2-3 (normal) ou 3-2-1 (invertida)
+    Leds123::write(1 << (s.direction == 0 ? s.index : 2 - s.index));
     
-    // Acende LED correto baseado na direção
-    if (direction == 0) {
-        // Sequência 1-2-3 (normal)
-        if (index == 0) SET_BIT(PORTD, LED1);
-        else if (index == 1) SET_BIT(PORTD, LED2);
-        else if (index == 2) SET_BIT(PORTB, LED3);
-    } else {
-        // Sequência 3-2-1 (invertida)
-        if (index == 0) SET_BIT(PORTB, LED3);
-        else if (index == 1) SET_BIT(PORTD, LED2);
-        else if (index == 2) SET_BIT(PORTD, LED1);
-    }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 3.4 - FREQUÊNCIA CRESCENTE ENQUANTO PRESSIONADO
 // ================================================================================
 void ex3_4() {
-    static unsigned long last_toggle = 0;
-    static uint16_t interval = 500;  // Começa em 500ms
-    static unsigned long last_decrease = 0;
-    
-    // Lê estado do botão (1 = solto, 0 = pressionado com pull-up)
-    uint8_t btn_pressed = READ_BIT(PINC, BTN1) == 0;  // 1 = pressionado
+    ex34_t &s = ex.ex34;
+    
+    // Pressionou: o pisca começa já (aceso); a primeira redução vem 200ms depois
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (!eh(&ev, EVT_PRESS, BTN1)) continue;
+        sched_per_inicia(&s.reduz, 200, SCHED_RAJADA);
+        led_blink(LED1_PINO, 2 * s.interval);
+    }
+    uint8_t btn_pressed = pressionado(BTN1);
     
     if (btn_pressed) {
-        // Diminui intervalo a cada 200ms (mais rápido)
-        if (millis_custom() - last_decrease >= 200) {
-            last_decrease = millis_custom();
-            if (interval > 20) {
-                interval -= 50;  // Diminui mais rapidamente
-            }
-        }
-        
-        // Pisca LED com intervalo atual
-        if (interval <= 0) {
-            // Frequência máxima = aceso fixo
-            SET_BIT(PORTD, LED1);
-        } else {
-            if (millis_custom() - last_toggle >= interval) {
-                last_toggle = millis_custom();
-                TGL_BIT(PORTD, LED1);
+        // Diminui intervalo a cada 200ms (mais rápido); o novo vale a
+        // partir da próxima troca do LED
+        if (sched_per_venceu(&s.reduz) && s.interval > 20) {
+            s.interval -= 50;  // Diminui mais rapidamente
+            if (s.interval == 0) {
+                // Frequência máxima = aceso fixo
+                led_fixo(LED1_PINO, 1);
+            } else {
+                led_blink(LED1_PINO, 2 * s.interval);
             }
         }
     } else {
         // Botão solto = apaga e reseta
-        CLR_BIT(PORTD, LED1);
-        interval = 500;  // Reseta intervalo
-        last_decrease = millis_custom();
+        led_fixo(LED1_PINO, 0);
+        s.interval = 500;  // Reseta intervalo
     }
+    
+    // O próximo deadline só existe enquanto o botão está pressionado
+    if (btn_pressed && s.interval > 20) sched_next_at(s.reduz.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 3.5 - CLIQUE AUMENTA FREQUÊNCIA, SEGURAR 5S APAGA
 // ================================================================================
 void ex3_5() {
-    static unsigned long last_toggle = 0;
-    static uint8_t freq_level = 0;  // 0-5 (0 = apagado, 5 = aceso fixo)
-    static unsigned long btn_press_start = 0;
-    static uint8_t btn_was_pressed = 0;
-    
-    // Intervalos para cada nível de frequência (ms)
-    const uint16_t intervals[6] = {0, 500, 250, 125, 62, 31};
-    
-    // Lê estado do botão (1 = solto, 0 = pressionado com pull-up)
-    uint8_t btn_pressed = READ_BIT(PINC, BTN1) == 0;
-    
-    // Detecta quando começou a pressionar
-    if (btn_pressed && !btn_was_pressed) {
-        btn_press_start = millis_custom();
-    }
-    
-    // Detecta clique (soltou após pressionar)
-    if (!btn_pressed && btn_was_pressed) {
-        unsigned long press_duration = millis_custom() - btn_press_start;
-        
-        // Se foi clique curto (< 500ms), aumenta frequência
-        if (press_duration < 500) {
-            freq_level++;
-            if (freq_level > 5) freq_level = 0;  // Volta ao início
-            last_toggle = millis_custom();
+    ex35_t &s = ex.ex35;
+    
+    // Período (aceso + apagado) de cada nível, em ms: trocas a cada
+    // 500, 250, 125 e 62ms (nível 5 = aceso fixo)
+    static const uint16_t periodos[5] = {0, 1000, 500, 250, 124};
+    
+    // CLICK (soltou em até 500ms) aumenta a frequência;
+    // LONG_PRESS (botoes_longo_ms = 5s) apaga
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (eh(&ev, EVT_CLICK, BTN1)) {
+            s.freq_level++;
+            if (s.freq_level > 5) s.freq_level = 0;  // Volta ao início
+        } else if (eh(&ev, EVT_LONG_PRESS, BTN1)) {
+            s.freq_level = 0;
         }
     }
     
-    // Se segurar por 5 segundos, apaga
-    if (btn_pressed && (millis_custom() - btn_press_start >= 5000)) {
-        freq_level = 0;
-    }
-    
-    btn_was_pressed = btn_pressed;
-    
-    // Controla LED baseado no nível de frequência
-    if (freq_level == 0) {
-        // Apagado
-        CLR_BIT(PORTD, LED1);
-    } else if (freq_level == 5) {
+    // Controla LED baseado no nível de frequência (0 = apagado). O pisca
+    // roda no OC2B: a tarefa só acorda com evento
+    if (s.freq_level == 5) {
         // Aceso fixo
-        SET_BIT(PORTD, LED1);
+        led_fixo(LED1_PINO, 1);
     } else {
-        // Pisca com intervalo correspondente
-        if (millis_custom() - last_toggle >= intervals[freq_level]) {
-            last_toggle = millis_custom();
-            TGL_BIT(PORTD, LED1);
-        }
+        led_blink(LED1_PINO, periodos[s.freq_level]);
     }
 }
 
@@ -359,20 +457,8 @@ void ex3_5() {
 // LED acende se qualquer um for pressionado; apaga se ambos forem pressionados
 // ================================================================================
 void ex3_6() {
-    // Lê estado dos botões (1 = solto, 0 = pressionado com pull-up)
-    uint8_t btn1_pressed = READ_BIT(PINC, BTN1) == 0;
-    uint8_t btn2_pressed = READ_BIT(PINC, BTN2) == 0;
-    
-    if (btn1_pressed && btn2_pressed) {
-        // Ambos pressionados = apaga
-        CLR_BIT(PORTD, LED1);
-    } else if (btn1_pressed || btn2_pressed) {
-        // Qualquer um pressionado = acende
-        SET_BIT(PORTD, LED1);
-    } else {
-        // Nenhum pressionado = apaga
-        CLR_BIT(PORTD, LED1);
-    }
+    acorde_t *a = &ex.ex36.acorde;
+    if (atualiza_acorde(a)) Led1::write(acorde_acao(a));
 }
 
 // ================================================================================
@@ -382,51 +468,27 @@ void ex3_6() {
 // Ambos → apaga
 // ================================================================================
 void ex3_7() {
-    static unsigned long last_blink = 0;
-    static uint8_t modo = 2;  // 2 = inativo, 0 = modo botão 1, 1 = modo botão 2
-    
-    // Detecta clique nos botões para trocar modo
-    if (btn_click[0]) {
-        btn_click[0] = 0;
-        modo = 0;  // Modo botão 1
-    }
-    
-    if (btn_click[1]) {
-        btn_click[1] = 0;
-        modo = 1;  // Modo botão 2
-    }
-    
-    // Lê estado dos botões
-    uint8_t btn1_pressed = READ_BIT(PINC, BTN1) == 0;
-    uint8_t btn2_pressed = READ_BIT(PINC, BTN2) == 0;
-    
-    if (btn1_pressed && btn2_pressed) {
-        // Ambos pressionados = apaga tudo
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-    } else if (modo != 2) {
-        // Executa modo atual (apenas se foi selecionado)
-        if (modo == 0) {
-            // Modo botão 1: LED1 aceso, LED2 piscando
-            SET_BIT(PORTD, LED1);
-            
-            if (millis_custom() - last_blink >= 150) {
-                last_blink = millis_custom();
-                TGL_BIT(PORTD, LED2);
-            }
-        } else {
-            // Modo botão 2: LED2 aceso, LED1 piscando
-            SET_BIT(PORTD, LED2);
-            
-            if (millis_custom() - last_blink >= 150) {
-                last_blink = millis_custom();
-                TGL_BIT(PORTD, LED1);
-            }
-        }
+    ex37_t &s = ex.ex37;
+    
+    // Botão sozinho troca o modo; o acorde dos dois apaga enquanto durar
+    if (!atualiza_acorde(&s.acorde)) return;
+    uint8_t acao = acorde_acao(&s.acorde);
+    if (acao == M37_MODO1) s.modo = 0;
+    else if (acao == M37_MODO2) s.modo = 1;
+    
+    // Pisca = troca a cada 150ms (lib/led); chamar de novo não reinicia a fase
+    if (acao == M37_APAGA || s.modo == 2) {
+        // Ambos pressionados ou nenhum modo selecionado = apaga tudo
+        led_fixo(LED1_PINO, 0);
+        led_fixo(LED2_PINO, 0);
+    } else if (s.modo == 0) {
+        // Modo botão 1: LED1 aceso, LED2 piscando
+        led_fixo(LED1_PINO, 1);
+        led_blink(LED2_PINO, 300);
     } else {
-        // Nenhum modo selecionado = apaga tudo
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
+        // Modo botão 2: LED2 aceso, LED1 piscando
+        led_fixo(LED2_PINO, 1);
+        led_blink(LED1_PINO, 300);
     }
 }
 
@@ -437,57 +499,37 @@ void ex3_7() {
 // Ambos → apagam
 // ================================================================================
 void ex3_8() {
-    static unsigned long last_update = 0;
-    static uint8_t index = 0;
+    ex38_t &s = ex.ex38;
     
-    // Lê estado dos botões (1 = solto, 0 = pressionado com pull-up)
-    uint8_t btn1_pressed = READ_BIT(PINC, BTN1) == 0;
-    uint8_t btn2_pressed = READ_BIT(PINC, BTN2) == 0;
+    atualiza_acorde(&s.acorde);
+    uint8_t acao = acorde_acao(&s.acorde);
     
-    // Verifica combinações
-    if (btn1_pressed && btn2_pressed) {
-        // Ambos pressionados = apaga tudo
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        index = 0;
+    if (acao == M38_PARA) {
+        // Nenhum botão ou ambos = apaga tudo
+        Leds123::clr();
+        s.index = 0;
+        s.parado = 1;
         return;
     }
     
-    if (!btn1_pressed && !btn2_pressed) {
-        // Nenhum botão = apaga tudo
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        index = 0;
-        return;
+    // Voltando de parado: o primeiro passo sai já e a contagem segue daqui
+    if (s.parado) {
+        s.parado = 0;
+        s.passo.proximo = tick16();
     }
     
     // Avança sequência a cada 150ms
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
+    if (sched_per_venceu(&s.passo)) {
         
-        // Apaga todos os LEDs
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        
-        if (btn1_pressed) {
-            // Sequência 1-2-3
-            if (index == 0) SET_BIT(PORTD, LED1);
-            else if (index == 1) SET_BIT(PORTD, LED2);
-            else if (index == 2) SET_BIT(PORTB, LED3);
-        } else if (btn2_pressed) {
-            // Sequência 3-2-1
-            if (index == 0) SET_BIT(PORTB, LED3);
-            else if (index == 1) SET_BIT(PORTD, LED2);
-            else if (index == 2) SET_BIT(PORTD, LED1);
-        }
+        // Só o LED do passo aceso: botão 1 = 1-2-3, botão 2 = 3-2-1
+        Leds123::write(1 << (acao == M38_SOBE ? s.index : 2 - s.index));
         
         // Avança índice
-        index++;
-        if (index >= 3) index = 0;
+        s.index++;
+        if (s.index >= 3) s.index = 0;
     }
+    
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
@@ -498,47 +540,8 @@ void ex3_8() {
 // Botão 1 + Botão 3 → todos apagam
 // ================================================================================
 void ex3_9() {
-    // Lê estado dos botões (1 = solto, 0 = pressionado com pull-up)
-    uint8_t btn1_pressed = READ_BIT(PINC, BTN1) == 0;
-    uint8_t btn2_pressed = READ_BIT(PINC, BTN2) == 0;
-    uint8_t btn3_pressed = READ_BIT(PINC, BTN3) == 0;
-    
-    // Verifica combinações de botões (ordem importa!)
-    if (btn1_pressed && btn3_pressed) {
-        // Botão 1 + Botão 3 = todos apagam
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        CLR_BIT(PORTB, LED4);
-    } 
-    else if (btn1_pressed) {
-        // Botão 1 sozinho = todos acesos
-        SET_BIT(PORTD, LED1);
-        SET_BIT(PORTD, LED2);
-        SET_BIT(PORTB, LED3);
-        SET_BIT(PORTB, LED4);
-    } 
-    else if (btn2_pressed) {
-        // Botão 2 = apenas LED1 e LED2
-        SET_BIT(PORTD, LED1);
-        SET_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        CLR_BIT(PORTB, LED4);
-    } 
-    else if (btn3_pressed) {
-        // Botão 3 = apenas LED3 e LED4
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        SET_BIT(PORTB, LED3);
-        SET_BIT(PORTB, LED4);
-    } 
-    else {
-        // Nenhum botão pressionado = todos apagam
-        CLR_BIT(PORTD, LED1);
-        CLR_BIT(PORTD, LED2);
-        CLR_BIT(PORTB, LED3);
-        CLR_BIT(PORTB, LED4);
-    }
+    acorde_t *a = &ex.ex39.acorde;
+    if (atualiza_acorde(a)) Leds::write(acorde_acao(a));
 }
 
 // ================================================================================
@@ -548,65 +551,44 @@ void ex3_9() {
 // Botão 3 → display "3"; LEDs: [1-OFF, 2-piscando, 3-OFF]
 // ================================================================================
 void ex3_10() {
-    static unsigned long last_blink = 0;
-    static uint8_t modo = 0;  // 0 = nenhum, 1/2/3 = modos
-    
-    // Detecta cliques nos botões
-    if (btn_click[0]) {
-        btn_click[0] = 0;
-        modo = 1;
-        last_blink = millis_custom();
-    }
-    if (btn_click[1]) {
-        btn_click[1] = 0;
-        modo = 2;
-        last_blink = millis_custom();
-    }
-    if (btn_click[2]) {
-        btn_click[2] = 0;
-        modo = 3;
-        last_blink = millis_custom();
+    ex310_t &s = ex.ex310;
+    
+    // Detecta cliques nos botões (cada pressão, na ordem em que ocorreu)
+    botoes_evento_t ev;
+    while (proximo_evento(&ev)) {
+        if (ev.tipo != EVT_PRESS) continue;
+        if (ev.botao == BTN1) s.modo = 1;
+        else if (ev.botao == BTN2) s.modo = 2;
+        else if (ev.botao == BTN3) s.modo = 3;
     }
     
     // Atualiza display com o modo atual
-    atualizar_display(modo);
+    atualizar_display(s.modo);
     
-    // Controla LEDs baseado no modo
-    switch (modo) {
+    // Controla LEDs baseado no modo (piscando = troca a cada 150ms, lib/led)
+    switch (s.modo) {
         case 1:  // Botão 1: LED1=ON, LED2=OFF, LED3=piscando
-            SET_BIT(PORTD, LED1);
-            CLR_BIT(PORTD, LED2);
-            
-            if (millis_custom() - last_blink >= 150) {
-                last_blink = millis_custom();
-                TGL_BIT(PORTB, LED3);
-            }
+            led_fixo(LED1_PINO, 1);
+            led_fixo(LED2_PINO, 0);
+            led_blink(LED3_PINO, 300);
             break;
             
         case 2:  // Botão 2: LED1=piscando, LED2=ON, LED3=ON
-            SET_BIT(PORTD, LED2);
-            SET_BIT(PORTB, LED3);
-            
-            if (millis_custom() - last_blink >= 150) {
-                last_blink = millis_custom();
-                TGL_BIT(PORTD, LED1);
-            }
+            led_fixo(LED2_PINO, 1);
+            led_fixo(LED3_PINO, 1);
+            led_blink(LED1_PINO, 300);
             break;
             
         case 3:  // Botão 3: LED1=OFF, LED2=piscando, LED3=OFF
-            CLR_BIT(PORTD, LED1);
-            CLR_BIT(PORTB, LED3);
-            
-            if (millis_custom() - last_blink >= 150) {
-                last_blink = millis_custom();
-                TGL_BIT(PORTD, LED2);
-            }
+            led_fixo(LED1_PINO, 0);
+            led_fixo(LED3_PINO, 0);
+            led_blink(LED2_PINO, 300);
             break;
             
         default:  // Nenhum modo = tudo apagado
-            CLR_BIT(PORTD, LED1);
-            CLR_BIT(PORTD, LED2);
-            CLR_BIT(PORTB, LED3);
+            led_fixo(LED1_PINO, 0);
+            led_fixo(LED2_PINO, 0);
+            led_fixo(LED3_PINO, 0);
             atualizar_display(0);  // Display apagado
             break;
     }
@@ -615,73 +597,125 @@ void ex3_10() {
 // ================================================================================
 // SETUP E LOOP
 // ================================================================================
-void setup() {
-    // Configura LEDs como saída
-    SET_BIT(DDRD, LED1);
-    SET_BIT(DDRD, LED2);
-    SET_BIT(DDRB, LED3);
-    SET_BIT(DDRB, LED4);
-    
-    // ========================================
-    // CONFIGURA PINOS DO DISPLAY COMO SAÍDA
-    // ========================================
-    // PORTC: SEG_A (PC0), SEG_B (PC1), SEG_C (PC5)
-    SET_BIT(DDRC, SEG_A);
-    SET_BIT(DDRC, SEG_B);
-    SET_BIT(DDRC, SEG_C);
-    CLR_BIT(PORTC, SEG_A);
-    CLR_BIT(PORTC, SEG_B);
-    CLR_BIT(PORTC, SEG_C);
-    
-    // PORTD: SEG_D (PD5), SEG_E (PD6), SEG_F (PD7) - além de LED1 e LED2
-    SET_BIT(DDRD, SEG_D);
-    SET_BIT(DDRD, SEG_E);
-    SET_BIT(DDRD, SEG_F);
-    CLR_BIT(PORTD, SEG_D);
-    CLR_BIT(PORTD, SEG_E);
-    CLR_BIT(PORTD, SEG_F);
-    
-    // PORTB: SEG_G (PB2) - além de LED3 e LED4
-    SET_BIT(DDRB, SEG_G);
-    CLR_BIT(PORTB, SEG_G);
-    
-    // Apaga todos LEDs
-    CLR_BIT(PORTD, LED1);
-    CLR_BIT(PORTD, LED2);
-    CLR_BIT(PORTB, LED3);
-    CLR_BIT(PORTB, LED4);
-    
-    // Configura botões como entrada com pull-up
-    CLR_BIT(DDRC, BTN1);
-    CLR_BIT(DDRC, BTN2);
-    CLR_BIT(DDRC, BTN3);
-    SET_BIT(PORTC, BTN1);
-    SET_BIT(PORTC, BTN2);
-    SET_BIT(PORTC, BTN3);
-    
-    // Inicializa Timer
+const sched_fn_t tarefas[10] = {
+    ex3_1, ex3_2, ex3_3, ex3_4, ex3_5,
+    ex3_6, ex3_7, ex3_8, ex3_9, ex3_10
+};
+
+// Quadro de telemetria a cada TELEMETRIA_MS (lib/telemetria)
+static void envia_telemetria() {
+    telemetria_envia(exercicio_atual, btn_estado);
+    sched_next(TELEMETRIA_MS);
+}
+
+#define M3_PINOS_B  PinosM3::mascara<PortB>()
+#define M3_PINOS_C  PinosM3::mascara<PortC>()
+#define M3_PINOS_D  PinosM3::mascara<PortD>()
+
+void modulo3_inicia(uint8_t ex) {
+    // Estado de uma passagem anterior pelo módulo (firmware único)
+    btn_estado = 0;
+    display_ultimo = 0xFF;
+    
+    // LEDs e segmentos passam pelas cópias (lib/sombra): começam apagados
+    // (1 escrita por porta) e só então viram saída
+    sombra_inicia(M3_PINOS_B, SEG_MASK_C, M3_PINOS_D);
+    Leds::clr();
+    Segmentos::clr();
+    sombra_commit();
+    Leds::output();
+    Segmentos::output();
+    
+    // Configura botões como entrada com pull-up + PCINT1
+    botoes_longo_ms = 5000;  // LONG_PRESS do Ex 3.5 (segurar 5s apaga)
+    botoes_init(BTN_MASK);
+    
+    // Inicializa Timer (no firmware único o setup() já iniciou os dois)
+#ifndef FIRMWARE_UNICO
     timer1_init();
+    serial_init();
+#endif
+    energia_desliga(ENERGIA_SEM_USO);
+    
+    exercicio_atual = ex;
+    if (exercicio_atual < 1 || exercicio_atual > 10) exercicio_atual = 2;
+    entra_exercicio(exercicio_atual);
+    
+    // Tarefas 0-9 = exercícios 3.1-3.10 (id == exercicio_atual - 1)
+    for (uint8_t i = 0; i < 10; i++) sched_add(tarefas[i]);
+    sched_agora(exercicio_atual - 1);
+    
+    // A telemetria não segura o chip acordado: no POWER_DOWN nada muda
+    uint8_t tel = sched_add(envia_telemetria);
+    sched_fundo(tel);
+    sched_agora(tel);
+}
+
+void modulo3_passo() {
+    // exercicio_atual trocado por fora (ex.: bench): a arena e a tarefa
+    // armada são do anterior. Para a tarefa dele antes que rode sobre a
+    // arena zerada do novo, e arma a do novo
+    if (exercicio_atual != ex_na_arena) {
+        if (exercicio_atual < 1 || exercicio_atual > 10) exercicio_atual = 2;
+        sched_stop(ex_na_arena - 1);
+        entra_exercicio(exercicio_atual);
+        sched_agora(exercicio_atual - 1);
+    }
     
+    // Evento novo na fila (gerado na ISR) acorda o exercício ativo
+    if (botoes_mudou()) {
+        sched_agora(exercicio_atual - 1);
+    }
+    sched_run();
+    sombra_commit();    // Uma escrita mascarada por porta que mudou
+}
+
+void modulo3_encerra() {
+    botoes_para();
+    led_para();
+    sombra_para();
+    energia_religa();
+}
+
+// Dentro da ISR de 1ms: debounce e os pisca-piscas sem OC
+static void modulo3_tick() {
+    botoes_tick();
+    led_tick();
+}
+
+const modulo_t MODULO3 PROGMEM = {
+    modulo3_inicia, modulo3_passo, modulo3_encerra, modulo3_tick,
+    1, 10, { M3_PINOS_B, M3_PINOS_C, M3_PINOS_D }
+};
+
+// ================================================================================
+// BUILD SEPARADO (pio run -e modulo3)
+// ================================================================================
+#ifndef FIRMWARE_UNICO
+// Chamado dentro da ISR do Timer1 (1ms)
+void timebase_tick_hook() {
+    modulo3_tick();
+}
+
+// Nada vencido e só a telemetria armada (interrupções desligadas). Sem
+// LED piscando, botão em debounce/janela de clique nem byte na serial,
+// só uma borda em PC2-PC4 muda algo: POWER_DOWN até a PCINT1. Com o
+// trace ligado fica em IDLE ('d' chega pela serial, que não acorda o chip)
+uint8_t sched_ocioso_hook() {
+    if (TRACE_ATIVO || led_ativo() || !botoes_ocioso() || !serial_ocioso()) return 0;
+    energia_power_down();
+    return 1;
+}
+
+void setup() {
     // ========================================
     // SELECIONE O EXERCÍCIO (1-10):
     // ========================================
-    exercicio_atual = 10;  // Ex 3.10 - Display 7 Segmentos + Botões + LEDs
+    modulo3_inicia(10);  // Ex 3.10 - Display 7 Segmentos + Botões + LEDs
 }
 
 void loop() {
-    ler_botoes();
-    
-    switch (exercicio_atual) {
-        case 1:  ex3_1();  break;
-        case 2:  ex3_2();  break;
-        case 3:  ex3_3();  break;
-        case 4:  ex3_4();  break;
-        case 5:  ex3_5();  break;
-        case 6:  ex3_6();  break;
-        case 7:  ex3_7();  break;
-        case 8:  ex3_8();  break;
-        case 9:  ex3_9();  break;
-        case 10: ex3_10(); break;
-        default: ex3_2();  break;
-    }
+    trace_comando();
+    modulo3_passo();
 }
+#endif
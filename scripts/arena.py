@@ -0,0 +1,51 @@
+# ================================================================================
+# ARENA - RELATÓRIO DE RAM POR EXERCÍCIO DEPOIS DO BUILD
+# ================================================================================
+# Lê do ELF os símbolos absolutos "arena_<exercício>" (ARENA_RELATA em
+# lib/arena/arena.h, valor = sizeof do estado) e o .data/.bss do firmware.
+# Com a union, a RAM de estado é o maior valor da lista, não a soma.
+# ================================================================================
+
+Import("env")
+
+import subprocess
+
+
+def secoes(elf):
+    size = env.subst("$CC").replace("gcc", "size")
+    saida = subprocess.check_output([size, "-A", elf], env=env["ENV"]).decode()
+    tam = {}
+    for linha in saida.splitlines():
+        partes = linha.split()
+        if len(partes) == 3 and partes[0].startswith("."):
+            tam[partes[0]] = int(partes[1])
+    return tam
+
+
+def estados(elf):
+    nm = env.subst("$CC").replace("gcc", "nm")
+    saida = subprocess.check_output([nm, elf], env=env["ENV"]).decode()
+    achados = []
+    for linha in saida.splitlines():
+        partes = linha.split()
+        if len(partes) == 3 and partes[1] == "A" and partes[2].startswith("arena_"):
+            achados.append((partes[2][len("arena_"):], int(partes[0], 16)))
+    return sorted(achados)
+
+
+def relata(source, target, env):
+    elf = str(target[0])
+    tam = secoes(elf)
+    print("RAM: .data %d + .bss %d bytes" % (tam.get(".data", 0), tam.get(".bss", 0)))
+    lista = estados(elf)
+    if not lista:
+        return
+    print("Estado por exercício (arena compartilhada):")
+    for nome, bytes_ in lista:
+        print("  %-12s %4d bytes" % (nome, bytes_))
+    maior = max(b for _, b in lista)
+    soma = sum(b for _, b in lista)
+    print("  arena = %d bytes (sem a union seriam %d)" % (maior, soma))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", relata)
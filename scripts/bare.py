@@ -0,0 +1,13 @@
+# ================================================================================
+# BARE - AJUSTE DE LINK DOS AMBIENTES bare_* (sem framework)
+# ================================================================================
+# Com LTO o código é gerado no link: as opções de geração de código dos
+# build_flags (-flto, -mcall-prologues) precisam ir também para o linker,
+# senão o ELF final sai sem elas.
+# ================================================================================
+
+Import("env")
+
+PARA_LINK = ("-flto", "-mcall-prologues")
+
+env.Append(LINKFLAGS=[f for f in env.get("CCFLAGS", []) if f in PARA_LINK])
@@ -27,17 +27,15 @@
  * ================================================================================
  */
 
-#include <Arduino.h> 
+#include "boot.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
-
-// ================================================================================
-// MACROS PARA MANIPULAÇÃO DE BITS
-// ================================================================================
-#define SET_BIT(REG, BIT)    (REG |= (1 << BIT))
-#define CLR_BIT(REG, BIT)    (REG &= ~(1 << BIT))
-#define TGL_BIT(REG, BIT)    (REG ^= (1 << BIT))
-#define READ_BIT(REG, BIT)   ((REG >> BIT) & 1)
+#include "timebase.h"
+#include "scheduler.h"
+#include "trace.h"
+#include "modulo.h"     // SET_BIT/CLR_BIT/TGL_BIT/READ_BIT
+#include "arena.h"
+#include "bam.h"
 
 // ================================================================================
 // DEFINIÇÕES DE PINOS
@@ -51,40 +49,116 @@
 // ================================================================================
 // VARIÁVEIS GLOBAIS
 // ================================================================================
-volatile unsigned long timer_millis = 0;
 uint8_t exercicio_atual = 0;  // 0=Ex1.1, 1=Ex1.2a, 2=Ex1.2b, etc.
 
 // ================================================================================
-// SISTEMA DE TIMER (Timer1 - 1ms)
+// ESTADO DOS EXERCÍCIOS (lib/arena)
 // ================================================================================
-void timer1_init() {
-    cli();
-    TCCR1A = 0;
-    TCCR1B = 0;
-    TCNT1 = 0;
-    OCR1A = 249;  // (16MHz / 64 / 1000Hz) - 1
-    SET_BIT(TCCR1B, WGM12);  // Modo CTC
-    SET_BIT(TCCR1B, CS11);   // Prescaler 64
-    SET_BIT(TCCR1B, CS10);
-    SET_BIT(TIMSK1, OCIE1A); // Interrupção
-    sei();
-}
+// Só o exercício escolhido roda: os estados dividem a mesma RAM (union 'est').
+// Cada um tem um sched_per_t: os passos avançam pelo período nominal, então
+// atraso de uma iteração não acumula (sem delay_ms() dentro das tarefas)
+typedef struct {
+    sched_per_t pisca;
+    uint8_t fase;               // 0-5: rápido, 6-11: devagar
+} ex1_t;
 
-ISR(TIMER1_COMPA_vect) {
-    timer_millis++;
-}
+typedef struct {
+    sched_per_t passo;
+    uint8_t step;
+    uint8_t leds;
+} ex2a_t, ex2b_t, ex2g_t;
 
-unsigned long millis_custom() {
-    unsigned long m;
-    cli();
-    m = timer_millis;
-    sei();
-    return m;
-}
+// 1.2c/1.2d: brilho de cada LED (lib/bam), o rastro apaga aos poucos
+typedef struct {
+    sched_per_t passo;
+    uint8_t position;
+    uint8_t brilho[8];
+} ex2c_t;
+
+typedef struct {
+    sched_per_t passo;
+    uint8_t position;
+    int8_t direction;
+    uint8_t brilho[8];
+} ex2d_t;
+
+typedef struct {
+    sched_per_t passo;
+    uint8_t position;
+    int8_t direction;
+    uint8_t leds;
+} ex2e_t;
 
-void delay_ms(unsigned long ms) {
-    unsigned long start = millis_custom();
-    while ((millis_custom() - start) < ms);
+typedef struct {
+    sched_per_t passo;
+    uint8_t step;
+    uint8_t blink_counter;
+    uint8_t leds;
+} ex2f_t;
+
+typedef struct {
+    sched_per_t passo;
+    uint8_t counter;
+} ex2h_t, ex2i_t;
+
+static union {
+    ex1_t ex1;
+    ex2a_t ex2a;
+    ex2b_t ex2b;
+    ex2c_t ex2c;
+    ex2d_t ex2d;
+    ex2e_t ex2e;
+    ex2f_t ex2f;
+    ex2g_t ex2g;
+    ex2h_t ex2h;
+    ex2i_t ex2i;
+} est;
+
+ARENA_RELATA(ex1_1, ex1_t)
+ARENA_RELATA(ex1_2a, ex2a_t)
+ARENA_RELATA(ex1_2b, ex2b_t)
+ARENA_RELATA(ex1_2c, ex2c_t)
+ARENA_RELATA(ex1_2d, ex2d_t)
+ARENA_RELATA(ex1_2e, ex2e_t)
+ARENA_RELATA(ex1_2f, ex2f_t)
+ARENA_RELATA(ex1_2g, ex2g_t)
+ARENA_RELATA(ex1_2h, ex2h_t)
+ARENA_RELATA(ex1_2i, ex2i_t)
+
+// Zera a arena, põe os valores iniciais do exercício n (0-9) e arma o
+// primeiro passo um período depois de agora. Contagens (1.2h/1.2i) saem em
+// rajada se perderem períodos, para o valor continuar valendo pelo tempo;
+// as demais pulam os períodos perdidos. 1.2c/1.2d desenham pelo BAM
+// (Timer2); nos outros PORTB é escrito direto
+void entra_exercicio(uint8_t n) {
+    ARENA_ZERA(est);
+    bam_para();
+    switch (n) {
+        case 0: sched_per_inicia(&est.ex1.pisca, 200, SCHED_PULA); break;
+        case 1: sched_per_inicia(&est.ex2a.passo, 200, SCHED_PULA); break;
+        case 2: sched_per_inicia(&est.ex2b.passo, 200, SCHED_PULA); break;
+        case 3:
+            sched_per_inicia(&est.ex2c.passo, 150, SCHED_PULA);
+            bam_inicia();
+            break;
+        case 4:
+            sched_per_inicia(&est.ex2d.passo, 100, SCHED_PULA);
+            est.ex2d.direction = 1;
+            bam_inicia();
+            break;
+        case 5:
+            sched_per_inicia(&est.ex2e.passo, 150, SCHED_PULA);
+            est.ex2e.direction = 1;
+            est.ex2e.leds = 0xFF;
+            break;
+        case 6: sched_per_inicia(&est.ex2f.passo, 200, SCHED_PULA); break;
+        case 7: sched_per_inicia(&est.ex2g.passo, 200, SCHED_PULA); break;
+        case 8: sched_per_inicia(&est.ex2h.passo, 250, SCHED_RAJADA); break;
+        case 9:
+            sched_per_inicia(&est.ex2i.passo, 250, SCHED_RAJADA);
+            est.ex2i.counter = 255;
+            break;
+    }
 }
 
 // ================================================================================
@@ -92,16 +166,16 @@ void delay_ms(unsigned long ms) {
 // 3x rápido (200ms) e 3x devagar (500ms), repetir eternamente
 // ================================================================================
 void modulo1_ex1() {
-    static unsigned long last_toggle = 0;
-    static uint8_t fase = 0;  // 0-5: rápido, 6-11: devagar
-    unsigned long intervalo = (fase < 6) ? 200 : 500;
+    ex1_t &s = est.ex1;
     
-    if (millis_custom() - last_toggle >= intervalo) {
-        last_toggle = millis_custom();
+    if (sched_per_vencido(&s.pisca)) {
         TGL_BIT(PORTC, LED_TESTE);
-        fase++;
-        if (fase >= 12) fase = 0;
+        s.fase++;
+        if (s.fase >= 12) s.fase = 0;
+        s.pisca.periodo = (s.fase < 6) ? 200 : 500;
+        sched_per_avanca(&s.pisca);
     }
+    sched_next_at(s.pisca.proximo);
 }
 
 // ================================================================================
@@ -109,27 +183,28 @@ void modulo1_ex1() {
 // Mantém acesos, apaga todos, repete
 // ================================================================================
 void modulo1_ex2a() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
+    ex2a_t &s = est.ex2a;
     
-    if (millis_custom() - last_update >= 200) {
-        last_update = millis_custom();
+    if (sched_per_vencido(&s.passo)) {
+        uint16_t espera = 200;
         
-        if (step < 8) {
-            SET_BIT(leds, step);
-            PORTB = leds;
-        } else if (step == 8) {
-            delay_ms(500);
-        } else if (step == 9) {
-            leds = 0;
+        if (s.step < 8) {
+            SET_BIT(s.leds, s.step);
+            PORTB = s.leds;
+        } else if (s.step == 8) {
+            espera += 500;      // Segura o bargraph cheio
+        } else if (s.step == 9) {
+            s.leds = 0;
             PORTB = 0;
-            delay_ms(300);
+            espera += 300;      // Segura apagado
         }
         
-        step++;
-        if (step >= 10) step = 0;
+        s.step++;
+        if (s.step >= 10) s.step = 0;
+        s.passo.periodo = espera;
+        sched_per_avanca(&s.passo);
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
@@ -137,92 +212,94 @@ void modulo1_ex2a() {
 // Mantém acesos, apaga todos, repete
 // ================================================================================
 void modulo1_ex2b() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
+    ex2b_t &s = est.ex2b;
     
-    if (millis_custom() - last_update >= 200) {
-        last_update = millis_custom();
+    if (sched_per_vencido(&s.passo)) {
+        uint16_t espera = 200;
         
-        if (step < 8) {
-            SET_BIT(leds, (7 - step));
-            PORTB = leds;
-        } else if (step == 8) {
-            delay_ms(500);
-        } else if (step == 9) {
-            leds = 0;
+        if (s.step < 8) {
+            SET_BIT(s.leds, (7 - s.step));
+            PORTB = s.leds;
+        } else if (s.step == 8) {
+            espera += 500;      // Segura o bargraph cheio
+        } else if (s.step == 9) {
+            s.leds = 0;
             PORTB = 0;
-            delay_ms(300);
+            espera += 300;      // Segura apagado
         }
         
-        step++;
-        if (step >= 10) step = 0;
+        s.step++;
+        if (s.step >= 10) s.step = 0;
+        s.passo.periodo = espera;
+        sched_per_avanca(&s.passo);
     }
+    sched_next_at(s.passo.proximo);
+}
+
+// Rastro: cada passo divide o brilho por 2 e a cabeça acende inteira.
+// Com o gamma, 255/127/63/31 saem como 255/55/12/2: cauda de ~3 LEDs
+static void rastro(uint8_t brilho[8], uint8_t cabeca) {
+    for (uint8_t i = 0; i < 8; i++) brilho[i] >>= 1;
+    brilho[cabeca] = 255;
+    bam_publica(brilho);
 }
 
 // ================================================================================
 // EXERCÍCIO 1.2c - Bargraph: Apenas 1 LED aceso por vez
-// Da direita para esquerda
+// Da direita para esquerda, com rastro apagando
 // ================================================================================
 void modulo1_ex2c() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
+    ex2c_t &s = est.ex2c;
     
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
-        PORTB = 1 << position;
-        position++;
-        if (position >= 8) position = 0;
+    if (sched_per_venceu(&s.passo)) {
+        rastro(s.brilho, s.position);
+        s.position++;
+        if (s.position >= 8) s.position = 0;
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 1.2d - Bargraph: Ping-pong
-// 1 LED aceso por vez, vai e volta
+// 1 LED aceso por vez, vai e volta, com rastro apagando
 // ================================================================================
 void modulo1_ex2d() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
-    static int8_t direction = 1;
+    ex2d_t &s = est.ex2d;
     
-    if (millis_custom() - last_update >= 100) {
-        last_update = millis_custom();
-        PORTB = 1 << position;
+    if (sched_per_venceu(&s.passo)) {
+        rastro(s.brilho, s.position);
         
-        position += direction;
+        s.position += s.direction;
         
-        if (position >= 7 && direction > 0) {
-            direction = -1;
-        } else if (position <= 0 && direction < 0) {
-            direction = 1;
+        if (s.position >= 7 && s.direction > 0) {
+            s.direction = -1;
+        } else if (s.position <= 0 && s.direction < 0) {
+            s.direction = 1;
         }
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 1.2e - Bargraph: Todos acesos, apagar 1 por vez em vai e volta
 // ================================================================================
 void modulo1_ex2e() {
-    static unsigned long last_update = 0;
-    static uint8_t position = 0;
-    static int8_t direction = 1;
-    static uint8_t leds = 0xFF;
+    ex2e_t &s = est.ex2e;
     
-    if (millis_custom() - last_update >= 150) {
-        last_update = millis_custom();
+    if (sched_per_venceu(&s.passo)) {
+        CLR_BIT(s.leds, s.position);
+        PORTB = s.leds;
         
-        CLR_BIT(leds, position);
-        PORTB = leds;
+        s.position += s.direction;
         
-        position += direction;
-        
-        if (position >= 7 && direction > 0) {
-            direction = -1;
-        } else if (position <= 0 && direction < 0) {
-            direction = 1;
-            leds = 0xFF;  // Reacende todos
+        if (s.position >= 7 && s.direction > 0) {
+            s.direction = -1;
+        } else if (s.position <= 0 && s.direction < 0) {
+            s.direction = 1;
+            s.leds = 0xFF;  // Reacende todos
         }
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
@@ -230,41 +307,41 @@ void modulo1_ex2e() {
 // Piscar todos 5x, apagar todos
 // ================================================================================
 void modulo1_ex2f() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t blink_counter = 0;
-    static uint8_t leds = 0;
+    ex2f_t &s = est.ex2f;
     
-    if (step < 8) {
-        if (millis_custom() - last_update >= 200) {
-            last_update = millis_custom();
-            SET_BIT(leds, (7 - step));
-            PORTB = leds;
-            step++;
-        }
-    } else if (step < 18) {
-        if (millis_custom() - last_update >= 200) {
-            last_update = millis_custom();
-            if (leds == 0xFF) {
-                leds = 0x00;
+    if (sched_per_vencido(&s.passo)) {
+        uint16_t espera = 200;
+        
+        if (s.step < 8) {
+            SET_BIT(s.leds, (7 - s.step));
+            PORTB = s.leds;
+            s.step++;
+        } else if (s.step < 18) {
+            if (s.leds == 0xFF) {
+                s.leds = 0x00;
             } else {
-                leds = 0xFF;
+                s.leds = 0xFF;
             }
-            PORTB = leds;
-            blink_counter++;
-            if (blink_counter >= 10) {
-                step = 18;
-                blink_counter = 0;
+            PORTB = s.leds;
+            s.blink_counter++;
+            if (s.blink_counter >= 10) {
+                s.step = 18;
+                s.blink_counter = 0;
+                espera = 0;     // Apaga em seguida
             } else {
-                step++;
+                s.step++;
             }
+        } else {
+            PORTB = 0;
+            s.step = 0;
+            s.leds = 0;
+            espera = 500;       // Segura apagado
         }
-    } else {
-        PORTB = 0;
-        delay_ms(500);
-        step = 0;
-        leds = 0;
+        
+        s.passo.periodo = espera;
+        sched_per_avanca(&s.passo);
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
@@ -272,71 +349,80 @@ void modulo1_ex2f() {
 // Depois esquerda para direita
 // ================================================================================
 void modulo1_ex2g() {
-    static unsigned long last_update = 0;
-    static uint8_t step = 0;
-    static uint8_t leds = 0;
+    ex2g_t &s = est.ex2g;
     
-    if (step < 8) {
-        if (millis_custom() - last_update >= 200) {
-            last_update = millis_custom();
-            SET_BIT(leds, step);
-            PORTB = leds;
-            step++;
-        }
-    } else if (step == 8) {
-        if (millis_custom() - last_update >= 500) {
-            last_update = millis_custom();
-            leds = 0;
+    if (sched_per_vencido(&s.passo)) {
+        uint16_t espera = 200;
+        
+        if (s.step < 8) {
+            SET_BIT(s.leds, s.step);
+            PORTB = s.leds;
+            s.step++;
+            if (s.step == 8) espera = 500;
+        } else if (s.step == 8) {
+            s.leds = 0;
             PORTB = 0;
-            step++;
-        }
-    } else if (step < 17) {
-        if (millis_custom() - last_update >= 200) {
-            last_update = millis_custom();
-            SET_BIT(leds, (7 - (step - 9)));
-            PORTB = leds;
-            step++;
+            s.step++;
+        } else if (s.step < 17) {
+            SET_BIT(s.leds, (7 - (s.step - 9)));
+            PORTB = s.leds;
+            s.step++;
+            if (s.step == 17) espera = 500;     // Segura o bargraph cheio
+        } else {
+            s.leds = 0;
+            PORTB = 0;
+            s.step = 0;
+            espera = 300;                       // Segura apagado
         }
-    } else {
-        delay_ms(500);
-        leds = 0;
-        PORTB = 0;
-        delay_ms(300);
-        step = 0;
+        
+        s.passo.periodo = espera;
+        sched_per_avanca(&s.passo);
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 1.2h - Bargraph: Contagem binária crescente 0-255
 // ================================================================================
 void modulo1_ex2h() {
-    static unsigned long last_update = 0;
-    static uint8_t counter = 0;
+    ex2h_t &s = est.ex2h;
     
-    if (millis_custom() - last_update >= 250) {
-        last_update = millis_custom();
-        PORTB = counter;
-        counter++;
+    if (sched_per_venceu(&s.passo)) {
+        PORTB = s.counter;
+        s.counter++;
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // EXERCÍCIO 1.2i - Bargraph: Contagem binária decrescente 255-0
 // ================================================================================
 void modulo1_ex2i() {
-    static unsigned long last_update = 0;
-    static uint8_t counter = 255;
+    ex2i_t &s = est.ex2i;
     
-    if (millis_custom() - last_update >= 250) {
-        last_update = millis_custom();
-        PORTB = counter;
-        counter--;
+    if (sched_per_venceu(&s.passo)) {
+        PORTB = s.counter;
+        s.counter--;
     }
+    sched_next_at(s.passo.proximo);
 }
 
 // ================================================================================
 // SETUP E LOOP
 // ================================================================================
+const sched_fn_t exercicios[10] = {
+    modulo1_ex1,   // 1.1 - Piscar LED 3x rápido/devagar
+    modulo1_ex2a,  // 1.2a - Direita→Esquerda mantendo
+    modulo1_ex2b,  // 1.2b - Esquerda→Direita mantendo
+    modulo1_ex2c,  // 1.2c - 1 LED por vez D→E
+    modulo1_ex2d,  // 1.2d - Ping-pong
+    modulo1_ex2e,  // 1.2e - Apagar 1 por vez vai-volta
+    modulo1_ex2f,  // 1.2f - E→D mantendo, piscar 5x
+    modulo1_ex2g,  // 1.2g - D→E, apagar, E→D
+    modulo1_ex2h,  // 1.2h - Contagem binária 0-255
+    modulo1_ex2i   // 1.2i - Contagem binária 255-0
+};
+
 void setup() {
     // Configura PORTB (LEDs do bargraph) como saída
     DDRB = 0xFF;  // PB0-PB7 como saída
@@ -348,25 +434,24 @@ void setup() {
     
     // Inicializa Timer1
     timer1_init();
+    trace_init();
     
     // ========================================
     // SELECIONE O EXERCÍCIO AQUI (0-9):
     // ========================================
     exercicio_atual = 0;  // 0=Ex1.1, 1=Ex1.2a, 2=Ex1.2b, ..., 9=Ex1.2i
+    if (exercicio_atual > 9) exercicio_atual = 0;
+    
+    entra_exercicio(exercicio_atual);
+    
+    // Uma tarefa por exercício (id == exercicio_atual); só a escolhida é armada
+    for (uint8_t i = 0; i < 10; i++) sched_add(exercicios[i]);
+    sched_agora(exercicio_atual);
 }
 
 void loop() {
-    switch (exercicio_atual) {
-        case 0:  modulo1_ex1();   break;  // 1.1 - Piscar LED 3x rápido/devagar
-        case 1:  modulo1_ex2a();  break;  // 1.2a - Direita→Esquerda mantendo
-        case 2:  modulo1_ex2b();  break;  // 1.2b - Esquerda→Direita mantendo
-        case 3:  modulo1_ex2c();  break;  // 1.2c - 1 LED por vez D→E
-        case 4:  modulo1_ex2d();  break;  // 1.2d - Ping-pong
-        case 5:  modulo1_ex2e();  break;  // 1.2e - Apagar 1 por vez vai-volta
-        case 6:  modulo1_ex2f();  break;  // 1.2f - E→D mantendo, piscar 5x
-        case 7:  modulo1_ex2g();  break;  // 1.2g - D→E, apagar, E→D
-        case 8:  modulo1_ex2h();  break;  // 1.2h - Contagem binária 0-255
-        case 9:  modulo1_ex2i();  break;  // 1.2i - Contagem binária 255-0
-        default: modulo1_ex1();   break;
-    }
+    trace_comando();
+
+    // Dorme em SLEEP_MODE_IDLE até o deadline do exercício ativo
+    sched_run();
 }
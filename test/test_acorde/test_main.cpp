@@ -0,0 +1,88 @@
+/*
+ * ================================================================================
+ * TESTES - ACORDE (COMBINAÇÕES DE BOTÕES COM JANELA)
+ * ================================================================================
+ * Só a lógica: os conjuntos e os tempos (ev.t) entram direto em
+ * acorde_muda()/acorde_vence(), sem debounce nem relógio.
+ */
+
+#include <unity.h>
+#include <avr/pgmspace.h>
+#include "mock_avr.h"
+#include "acorde.h"
+
+// Botões em PC2, PC3 e PC4 (como no Módulo 3)
+#define A   (1 << 2)
+#define B   (1 << 3)
+#define C   (1 << 4)
+
+enum { NADA, SO_A, SO_B, AB, AC };
+
+const acorde_entrada_t TABELA[] PROGMEM = {
+    { 0,     NADA },
+    { A,     SO_A },
+    { B,     SO_B },
+    { A | B, AB },
+    { A | C, AC },
+};
+
+static acorde_t a;
+
+void setUp() {
+    acorde_inicia(&a, TABELA, sizeof(TABELA) / sizeof(TABELA[0]), A | B | C, 40);
+}
+
+void tearDown() {}
+
+// Sem entrada própria: a mais específica contida; empate = ordem da tabela
+void test_resolucao_da_tabela() {
+    TEST_ASSERT_EQUAL_UINT8(NADA, acorde_acao(&a));
+    TEST_ASSERT_EQUAL_UINT8(SO_A, a.acao[1]);           // A
+    TEST_ASSERT_EQUAL_UINT8(NADA, a.acao[4]);           // C
+    TEST_ASSERT_EQUAL_UINT8(SO_B, a.acao[6]);           // B + C
+    TEST_ASSERT_EQUAL_UINT8(AB, a.acao[7]);             // A + B + C
+    // Não esperam: AB (ABC também é AB) e ABC; os outros ainda mudam
+    TEST_ASSERT_EQUAL_HEX8(0x77, a.espera);
+}
+
+// B 10ms depois de A: SO_A nunca vale, AB fecha na hora (nada maior muda)
+void test_acorde_dentro_da_janela() {
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_muda(&a, A, 1000));
+    TEST_ASSERT_TRUE(acorde_pendente(&a));
+    TEST_ASSERT_EQUAL_UINT16(1040, acorde_prazo(&a));
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_vence(&a, 1005));
+    TEST_ASSERT_EQUAL_UINT8(NADA, acorde_acao(&a));
+
+    TEST_ASSERT_EQUAL_UINT8(1, acorde_muda(&a, A | B, 1010));
+    TEST_ASSERT_FALSE(acorde_pendente(&a));
+    TEST_ASSERT_EQUAL_UINT8(AB, acorde_acao(&a));
+
+    // Soltando A primeiro: sobra B, que espera a janela; soltar B a seguir
+    // fecha sem SO_B
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_muda(&a, B, 1200));
+    TEST_ASSERT_EQUAL_UINT8(AB, acorde_acao(&a));
+    TEST_ASSERT_EQUAL_UINT8(1, acorde_muda(&a, 0, 1215));
+    TEST_ASSERT_EQUAL_UINT8(NADA, acorde_acao(&a));
+}
+
+// A sozinho vale quando a janela fecha (atraso = janela), também com o
+// contador de 16 bits virando
+void test_botao_sozinho_no_prazo() {
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_muda(&a, A, 0xFFF0));
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_vence(&a, 0x0016));
+    TEST_ASSERT_EQUAL_UINT8(1, acorde_vence(&a, 0x0018));
+    TEST_ASSERT_EQUAL_UINT8(SO_A, acorde_acao(&a));
+    TEST_ASSERT_EQUAL_UINT8(0, acorde_vence(&a, 0x0100));
+
+    // Fora da janela, B vira AB na hora
+    TEST_ASSERT_EQUAL_UINT8(1, acorde_muda(&a, A | B, 0x0200));
+    TEST_ASSERT_EQUAL_UINT8(AB, acorde_acao(&a));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_resolucao_da_tabela);
+    RUN_TEST(test_acorde_dentro_da_janela);
+    RUN_TEST(test_botao_sozinho_no_prazo);
+    return UNITY_END();
+}
@@ -0,0 +1,79 @@
+/*
+ * ================================================================================
+ * TESTES - src/main.cpp (MÓDULO 1 ORIGINAL) RODANDO NO HOST
+ * ================================================================================
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "../../src/main.cpp"
+
+static void roda_ate(unsigned long t) {
+    while ((long)(millis_custom() - t) < 0) loop();
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    sched_limpa();
+    setup();
+}
+
+void tearDown() {}
+
+// Ex 1.1: PC5 troca a cada 200ms nas 6 primeiras fases
+void test_ex1_pisca_200ms() {
+    uint8_t trocas = 0;
+    uint8_t led = READ_BIT(PORTC, LED_TESTE);
+
+    while (millis_custom() < 1300) {
+        loop();
+        if (READ_BIT(PORTC, LED_TESTE) != led) {
+            led = READ_BIT(PORTC, LED_TESTE);
+            trocas++;
+            TEST_ASSERT_EQUAL_UINT32(0, millis_custom() % 200);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(6, trocas);
+}
+
+// Ex 1.2h: contagem binária a cada 250ms
+void test_ex2h_contagem() {
+    sched_stop(exercicio_atual);
+    exercicio_atual = 8;
+    entra_exercicio(exercicio_atual);
+    sched_agora(exercicio_atual);
+
+    // Primeiro valor (0) em 250ms, depois +1 a cada 250ms
+    roda_ate(251);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTB);
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_HEX8(3, PORTB);
+}
+
+// Ex 1.2d: passos em 100/200/300ms deixam LED2 inteiro e o rastro em LED1
+// e LED0 (brilho 127 e 63); PORTB amostrado num quadro do BAM
+void test_ex2d_rastro() {
+    sched_stop(exercicio_atual);
+    exercicio_atual = 4;
+    entra_exercicio(exercicio_atual);
+    sched_agora(exercicio_atual);
+
+    roda_ate(320);
+    uint16_t aceso[3] = { 0, 0, 0 };
+    for (uint16_t i = 0; i < BAM_CONTAGENS; i++) {
+        mock_avanca_ciclos(256);
+        for (uint8_t c = 0; c < 3; c++) aceso[c] += (PORTB >> c) & 1;
+    }
+    TEST_ASSERT_EQUAL_UINT16(2 * bam_gamma(63), aceso[0]);
+    TEST_ASSERT_EQUAL_UINT16(2 * bam_gamma(127), aceso[1]);
+    TEST_ASSERT_EQUAL_UINT16(BAM_CONTAGENS, aceso[2]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ex1_pisca_200ms);
+    RUN_TEST(test_ex2h_contagem);
+    RUN_TEST(test_ex2d_rastro);
+    return UNITY_END();
+}
@@ -0,0 +1,103 @@
+/*
+ * ================================================================================
+ * TESTES - BAM (BRILHO POR PLANOS DE BIT NO TIMER2)
+ * ================================================================================
+ * PORTB é amostrado a cada contagem do Timer2 (256 ciclos): num quadro
+ * inteiro (510 contagens) cada LED fica aceso 2 * gamma(brilho) contagens.
+ */
+
+#include <unity.h>
+#include <avr/io.h>
+#include "mock_avr.h"
+#include "bam.h"
+
+#define CICLOS_CONTAGEM     256
+
+// Contagens acesas de cada LED em 'n' contagens seguidas
+static void amostra(uint16_t n, uint16_t aceso[8]) {
+    for (uint8_t c = 0; aceso && c < 8; c++) aceso[c] = 0;
+    while (n--) {
+        mock_avanca_ciclos(CICLOS_CONTAGEM);
+        for (uint8_t c = 0; aceso && c < 8; c++) aceso[c] += (PORTB >> c) & 1;
+    }
+}
+
+static void espera_quadros(uint8_t n) {
+    uint8_t q = bam_quadros;
+    while ((uint8_t)(bam_quadros - q) < n) mock_avanca_ciclos(CICLOS_CONTAGEM);
+}
+
+void setUp() {
+    mock_reset();
+    SREG |= (1 << SREG_I);
+    DDRB = 0xFF;
+    bam_inicia();
+}
+
+void tearDown() {
+    bam_para();
+}
+
+void test_duty_segue_o_gamma() {
+    static const uint8_t brilho[8] = { 0, 1, 16, 64, 128, 200, 254, 255 };
+    uint16_t aceso[8];
+
+    bam_publica(brilho);
+    espera_quadros(2);
+    amostra(BAM_CONTAGENS, aceso);
+    for (uint8_t c = 0; c < 8; c++) {
+        TEST_ASSERT_EQUAL_UINT16(2 * bam_gamma(brilho[c]), aceso[c]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(BAM_CONTAGENS, aceso[7]);
+}
+
+// Quadro publicado no meio de outro: o atual vai até o fim, o novo entra
+// inteiro no início do seguinte
+void test_troca_so_no_fim_do_quadro() {
+    static const uint8_t antes[8] = { 255, 0, 0, 0, 0, 0, 0, 0 };
+    static const uint8_t depois[8] = { 0, 0, 0, 0, 0, 0, 0, 255 };
+    uint16_t aceso[8];
+
+    bam_publica(antes);
+    espera_quadros(2);
+    amostra(100, aceso);
+    uint8_t q = bam_quadros;
+    bam_publica(depois);
+
+    // Resto do quadro: ainda o antigo. bam_quadros conta quando o último
+    // plano (256 contagens) vai para a saída
+    while (bam_quadros == q) {
+        TEST_ASSERT_EQUAL_HEX8(0x01, PORTB);
+        mock_avanca_ciclos(CICLOS_CONTAGEM);
+    }
+    for (uint16_t i = 0; i < 256; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0x01, PORTB);
+        mock_avanca_ciclos(CICLOS_CONTAGEM);
+    }
+    amostra(BAM_CONTAGENS, aceso);
+    TEST_ASSERT_EQUAL_UINT16(0, aceso[0]);
+    TEST_ASSERT_EQUAL_UINT16(BAM_CONTAGENS, aceso[7]);
+}
+
+// Interrupções desligadas atrasam a entrada na ISR, mas o próximo compare
+// é contado do anterior: o quadro continua com 510 contagens
+void test_atraso_na_isr_nao_desloca_o_quadro() {
+    espera_quadros(1);
+    uint64_t inicio = mock_ciclos();
+
+    amostra(3, 0);
+    SREG &= ~(1 << SREG_I);
+    mock_avanca_ciclos(300);                // ~19µs sem interrupções
+    SREG |= (1 << SREG_I);
+    mock_avanca_ciclos(2 * CICLOS_CONTAGEM - 300);
+    espera_quadros(2);
+    TEST_ASSERT_EQUAL_UINT32(2UL * BAM_CONTAGENS * CICLOS_CONTAGEM, (uint32_t)(mock_ciclos() - inicio));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_duty_segue_o_gamma);
+    RUN_TEST(test_troca_so_no_fim_do_quadro);
+    RUN_TEST(test_atraso_na_isr_nao_desloca_o_quadro);
+    return UNITY_END();
+}
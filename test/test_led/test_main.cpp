@@ -0,0 +1,132 @@
+/*
+ * ================================================================================
+ * TESTES - PISCA-PISCA PELO HARDWARE (lib/led)
+ * ================================================================================
+ * O loop não roda: só o relógio virtual e as ISRs. O nível dos pinos com
+ * OC conectado vem de mock_saida_b/d(); as bordas são medidas em ciclos.
+ */
+
+#include <unity.h>
+#include <avr/io.h>
+#include "mock_avr.h"
+#include "timebase.h"
+#include "led.h"
+#include "bam.h"
+
+#define LED_PD4     LED_PINO(LED_PORTD, 4)
+
+void timebase_tick_hook() {
+    led_tick();
+}
+
+// Ciclos entre bordas seguidas de um bit, avançando de 'passo' em 'passo'
+static void bordas(uint8_t (*saida)(void), uint8_t bit, uint32_t passo,
+                   uint8_t n, uint64_t *t) {
+    uint8_t ant = (saida() >> bit) & 1;
+    uint8_t i = 0;
+    while (i < n) {
+        mock_avanca_ciclos(passo);
+        uint8_t v = (saida() >> bit) & 1;
+        if (v != ant) t[i++] = mock_ciclos();
+        ant = v;
+    }
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    timer1_init();
+    DDRB = DDRD = 0xFF;
+}
+
+void tearDown() {
+    led_para();
+}
+
+// 1kHz no PD3: CTC sem interrupção nenhuma, meio período de 8000 ciclos
+void test_frequencia_no_oc2b() {
+    uint64_t t[5];
+    led_set_frequency(LED_PINO_OC2B, 1000);
+    TEST_ASSERT_EQUAL_HEX8(0, TIMSK2 & (1 << OCIE2B));
+
+    bordas(mock_saida_d, PD3, 8, 5, t);
+    for (uint8_t i = 1; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT32(8000, (uint32_t)(t[i] - t[i - 1]));
+    }
+}
+
+// Trocas a cada 31ms (62ms de período): 484,375 contagens de 64µs, o resto
+// fracionário acumula e 8 meios períodos dão 248ms exatos
+void test_pisca_lento_sem_deriva() {
+    uint64_t t[9];
+    led_blink(LED_PINO_OC2B, 62);
+    mock_avanca_ciclos(4 * 1024);           // Acende no compare logo adiante
+    TEST_ASSERT_TRUE(mock_saida_d() & (1 << PD3));
+
+    bordas(mock_saida_d, PD3, 1024, 9, t);
+    for (uint8_t i = 1; i < 9; i++) {
+        uint32_t d = (uint32_t)(t[i] - t[i - 1]);
+        TEST_ASSERT_TRUE(d == 484UL * 1024 || d == 485UL * 1024);
+    }
+    TEST_ASSERT_EQUAL_UINT32(248UL * 16000, (uint32_t)(t[8] - t[0]));
+}
+
+// PB1 (OC1A) troca no compare do Timer1; PD4 troca na ISR de 1ms. Com o
+// período mudado no meio, o novo vale a partir da troca seguinte
+void test_oc1a_e_software() {
+    uint64_t t[3];
+    led_blink(LED_PINO_OC1A, 20);
+    led_blink(LED_PD4, 6);
+    TEST_ASSERT_TRUE(PORTD & (1 << PD4));
+    mock_avanca_ms(2);
+    TEST_ASSERT_TRUE(mock_saida_b() & (1 << PB1));
+
+    bordas(mock_saida_b, PB1, 64, 3, t);
+    TEST_ASSERT_EQUAL_UINT32(10UL * 16000, (uint32_t)(t[1] - t[0]));
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(t[0] % 16000));
+
+    led_blink(LED_PD4, 10);
+    bordas(mock_saida_d, PD4, 64, 3, t);
+    TEST_ASSERT_EQUAL_UINT32(5UL * 16000, (uint32_t)(t[2] - t[1]));
+
+    led_fixo(LED_PINO_OC1A, 1);
+    TEST_ASSERT_EQUAL_HEX8(0, TCCR1A);
+    TEST_ASSERT_TRUE(PORTB & (1 << PB1));
+}
+
+// Fora do PD3, acima de 500Hz o período fica em 2ms (troca a cada ms) em
+// vez de 1000 / hz = 0, que apagava o LED
+void test_frequencia_fora_do_oc2b() {
+    uint64_t t[3];
+    led_set_frequency(LED_PD4, 2000);
+    TEST_ASSERT_TRUE(led_ativo());
+    bordas(mock_saida_d, PD4, 64, 3, t);
+    TEST_ASSERT_EQUAL_UINT32(16000, (uint32_t)(t[2] - t[1]));
+}
+
+// lib/bam e lib/led na mesma imagem: o compare B (lib/timer2) vai para
+// quem armou o Timer2 por último
+void test_compare_b_troca_de_dono() {
+    bam_inicia();
+    mock_avanca_ms(20);
+    uint8_t q = bam_quadros;
+    TEST_ASSERT_TRUE(q >= 2);
+    bam_para();
+
+    led_blink(LED_PINO_OC2B, 62);
+    mock_avanca_ciclos(4 * 1024);
+    TEST_ASSERT_TRUE(mock_saida_d() & (1 << PD3));
+    mock_avanca_ms(32);
+    TEST_ASSERT_FALSE(mock_saida_d() & (1 << PD3));
+    TEST_ASSERT_EQUAL_UINT8(q, bam_quadros);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frequencia_no_oc2b);
+    RUN_TEST(test_pisca_lento_sem_deriva);
+    RUN_TEST(test_oc1a_e_software);
+    RUN_TEST(test_frequencia_fora_do_oc2b);
+    RUN_TEST(test_compare_b_troca_de_dono);
+    return UNITY_END();
+}
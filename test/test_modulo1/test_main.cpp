@@ -0,0 +1,171 @@
+/*
+ * ================================================================================
+ * TESTES - MÓDULO 1 (LEDs) RODANDO NO HOST
+ * ================================================================================
+ * O módulo é incluído inteiro; setup()/loop() rodam sobre o relógio virtual
+ * (loop() dorme no escalonador → o mock avança até o próximo tick).
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "../../modulos/modulo1_leds.cpp"
+
+// Para assim que o relógio chega em t: tarefas que vencem em t só rodam
+// na próxima chamada de loop()
+static void roda_ate(unsigned long t) {
+    while ((long)(millis_custom() - t) < 0) loop();
+}
+
+// Fixa um exercício (sem a troca automática da playlist)
+static void so_exercicio(uint8_t ex) {
+    sched_stop(exercicio_atual);
+    sched_stop(tarefa_troca);
+    exercicio_atual = ex;
+    inicia_exercicio();
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    sched_limpa();
+    setup();
+}
+
+void tearDown() {}
+
+// Ex 1.1: 6 trocas a cada 200ms, depois a cada 500ms
+void test_ex1_pisca_rapido_depois_devagar() {
+    const unsigned long esperado[7] = { 200, 400, 600, 800, 1000, 1200, 1700 };
+    unsigned long trocas[7];
+    uint8_t n = 0;
+    uint8_t led = READ_BIT(PORTC, LED_TESTE_PIN);
+
+    while (millis_custom() < 2000 && n < 7) {
+        loop();
+        if (READ_BIT(PORTC, LED_TESTE_PIN) != led) {
+            led = READ_BIT(PORTC, LED_TESTE_PIN);
+            trocas[n++] = millis_custom();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(7, n);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(esperado, trocas, 7);
+}
+
+// O 1.1 acaba com o último frame (6×200 + 6×500 = 4200ms), pausa 700ms
+// com os pinos em alta impedância e o 1.2a começa acumulando do PB0
+void test_troca_para_o_proximo_exercicio() {
+    roda_ate(4199);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, DDRB);
+    roda_ate(4201);
+    TEST_ASSERT_EQUAL_UINT8(0, exercicio_atual);
+    TEST_ASSERT_EQUAL_HEX8(0x00, DDRB);
+    TEST_ASSERT_EQUAL_HEX8(0x00, PORTB);
+    TEST_ASSERT_FALSE(READ_BIT(PORTC, LED_TESTE_PIN));
+    roda_ate(4901);
+    TEST_ASSERT_EQUAL_UINT8(1, exercicio_atual);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, DDRB);
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTB);
+}
+
+// A pausa entre exercícios não bloqueia: loop() volta a cada tick
+void test_pausa_nao_bloqueia() {
+    roda_ate(4300);
+    uint32_t dormidas = sched_dormidas;
+    loop();
+    TEST_ASSERT_EQUAL_UINT32(4301, millis_custom());
+    TEST_ASSERT_EQUAL_UINT32(dormidas + 1, sched_dormidas);
+}
+
+// Stream (1.2c, 8 frames × 75ms × 2 voltas): o último frame fica os 75ms
+// dele e o stream para sem reescrever o primeiro; o BAM para junto
+void test_stream_acaba_nas_voltas() {
+    sched_limpa();
+    modulo1_inicia(3);
+    roda_ate(1 + 15 * 75 + 1);
+    TEST_ASSERT_EQUAL_HEX8(0x80, SOMBRA_PORTB);
+    TEST_ASSERT_EQUAL_UINT8(255, brilho[7]);
+    roda_ate(1 + 16 * 75 + 1);
+    TEST_ASSERT_EQUAL_HEX8(0x00, DDRB);
+    TEST_ASSERT_EQUAL_HEX8(0x00, PORTB);
+    TEST_ASSERT_EQUAL_HEX8(0, TIMSK2 & (1 << OCIE2B));
+    roda_ate(1 + 16 * 75 + SEQ_PAUSA_MS + 2);
+    TEST_ASSERT_EQUAL_UINT8(4, exercicio_atual);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, DDRB);
+}
+
+// Exercícios gerados saem pela ISR de 1ms: 1.2e = apaga 1 por vez a cada 75ms
+void test_stream_um_led_por_vez() {
+    so_exercicio(5);
+    unsigned long inicio = millis_custom();
+
+    for (uint8_t i = 0; i < 10; i++) {
+        roda_ate(inicio + 1 + (unsigned long)i * 75);
+        TEST_ASSERT_EQUAL_HEX8(GeraApagaUmPorVez::frame(i), PORTB);
+        TEST_ASSERT_EQUAL_UINT8(GeraApagaUmPorVez::frame(i) >> 7, READ_BIT(PORTC, LED_D7_PIN));
+    }
+}
+
+// 1.2c pelo BAM: a cabeça fica em todos os planos do quadro, o LED de
+// antes (brilho 127 → 55 com gamma) só em parte deles; o D7 (PC0) só
+// acende com a cabeça. A ISR de 1ms não publica (uma passada dela fica
+// abaixo do plano mais curto)
+void test_rastro_pelo_bam() {
+    so_exercicio(3);
+    unsigned long inicio = millis_custom();
+
+    for (uint8_t i = 1; i < 9; i++) {
+        uint8_t cabeca = i & 7, antes = (i - 1) & 7;
+        // Frame na ISR, brilho publicado no loop() seguinte
+        roda_ate(inicio + 2 + (unsigned long)i * 75);
+        TEST_ASSERT_EQUAL_UINT8(255, brilho[cabeca]);
+        TEST_ASSERT_EQUAL_UINT8(127, brilho[antes]);
+
+        // Dois quadros BAM para a troca de buffers, depois um quadro inteiro
+        mock_avanca_ms(17);
+        uint8_t sempre = 0xFF, algum = 0;
+        for (uint16_t us = 0; us < 8200; us += 16) {
+            mock_avanca_us(16);
+            sempre &= PORTB;
+            algum |= PORTB;
+        }
+        TEST_ASSERT_TRUE(sempre & (1 << cabeca));
+        TEST_ASSERT_FALSE(sempre & (1 << antes));
+        TEST_ASSERT_TRUE(algum & (1 << antes));
+        TEST_ASSERT_EQUAL_UINT8(cabeca == 7, READ_BIT(PORTC, LED_D7_PIN));
+    }
+}
+
+// Tabelas geradas em tempo de compilação
+void test_tabela_ping_pong() {
+    const uint8_t esperado[14] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+        0x40, 0x20, 0x10, 0x08, 0x04, 0x02
+    };
+    TEST_ASSERT_EQUAL_UINT8(14, anim_tabela<GeraPingPong>::n);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(esperado, anim_tabela<GeraPingPong>::frames, 14);
+}
+
+// Contagem 0→255 (1.2h): um passo a cada 150ms
+void test_contagem_binaria() {
+    so_exercicio(8);
+    unsigned long inicio = millis_custom();
+
+    TEST_ASSERT_EQUAL_HEX8(0x00, PORTB);
+    roda_ate(inicio + 151);
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTB);
+    roda_ate(inicio + 150 * 200 + 1);
+    TEST_ASSERT_EQUAL_HEX8(200, PORTB);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ex1_pisca_rapido_depois_devagar);
+    RUN_TEST(test_troca_para_o_proximo_exercicio);
+    RUN_TEST(test_pausa_nao_bloqueia);
+    RUN_TEST(test_stream_acaba_nas_voltas);
+    RUN_TEST(test_stream_um_led_por_vez);
+    RUN_TEST(test_rastro_pelo_bam);
+    RUN_TEST(test_tabela_ping_pong);
+    RUN_TEST(test_contagem_binaria);
+    return UNITY_END();
+}
@@ -0,0 +1,69 @@
+/*
+ * ================================================================================
+ * TESTES - MÓDULO 2 (MULTIPLEXAÇÃO PELO TIMER2)
+ * ================================================================================
+ * O main() do módulo nunca retorna: ele é renomeado e só a ISR de varredura
+ * (mux_init + TIMER2_COMPA_vect) é exercitada sobre o relógio virtual.
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+
+#define main modulo2_main
+#include "../../modulos/modulo2_displays.cpp"
+#undef main
+
+// Uma contagem do Timer2 (prescaler 256)
+#define TICK_CICLOS     MUX_PRESCALER
+
+void setUp() {
+    mock_reset();
+    DDRB = 0x7F;
+    DDRC = MUX_SEL_MASK;
+    display_fb[0] = 0x1;
+    display_fb[1] = 0xE;
+    mux_init();
+}
+
+void tearDown() {}
+
+// Nunca os dois dígitos ao mesmo tempo, e cada um com o seu padrão
+void test_varredura_dos_dois_digitos() {
+    uint16_t aceso[MUX_NUM_DIGITOS] = {0, 0};
+
+    for (uint16_t i = 0; i < 4 * MUX_TICKS_DIGITO * MUX_NUM_DIGITOS; i++) {
+        mock_avanca_ciclos(TICK_CICLOS);
+        uint8_t sel = PORTC & MUX_SEL_MASK;
+        TEST_ASSERT_TRUE(sel != MUX_SEL_MASK);
+        if (sel == mux_sel[0]) {
+            TEST_ASSERT_EQUAL_HEX8(hexa[0x1], PORTB);
+            aceso[0]++;
+        } else if (sel == mux_sel[1]) {
+            TEST_ASSERT_EQUAL_HEX8(hexa[0xE], PORTB);
+            aceso[1]++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT16(aceso[0], aceso[1]);
+    TEST_ASSERT_EQUAL_UINT16(4 * (MUX_OCR_ACESO + 1), aceso[0]);
+}
+
+// Em 1s: MUX_REFRESH_HZ varreduras, apagado MUX_TICKS_BLANK por dígito
+void test_taxa_e_blanking() {
+    uint8_t q0 = mux_quadros;
+    uint32_t apagado = 0;
+    uint32_t total = F_CPU / TICK_CICLOS;
+
+    for (uint32_t i = 0; i < total; i++) {
+        mock_avanca_ciclos(TICK_CICLOS);
+        if (!(PORTC & MUX_SEL_MASK)) apagado++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(MUX_REFRESH_HZ, (uint8_t)(mux_quadros - q0));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)MUX_REFRESH_HZ * MUX_NUM_DIGITOS * MUX_TICKS_BLANK, apagado);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_varredura_dos_dois_digitos);
+    RUN_TEST(test_taxa_e_blanking);
+    return UNITY_END();
+}
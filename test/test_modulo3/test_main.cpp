@@ -0,0 +1,318 @@
+/*
+ * ================================================================================
+ * TESTES - MÓDULO 3 (BOTÕES COM DEBOUNCE + FILA DE EVENTOS)
+ * ================================================================================
+ * Os botões são níveis em PINC (pull-up: pressionado = 0); mock_pinc()
+ * também dispara a PCINT1 que acorda a CPU. O tempo dos testes é o do
+ * relógio virtual (mock_ciclos): em POWER_DOWN o millis_custom() para.
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "../../modulos/modulo3_botoes.cpp"
+
+static void botao(uint8_t btn, uint8_t apertado) {
+    if (apertado) mock_pinc(PINC & ~(1 << btn));
+    else mock_pinc(PINC | (1 << btn));
+}
+
+static void roda_ms(unsigned long ms) {
+    uint64_t fim = mock_ciclos() + (uint64_t)ms * (F_CPU / 1000UL);
+    mock_limite_sono(fim);
+    while (mock_ciclos() < fim) loop();
+    mock_limite_sono(0);
+}
+
+static void troca_exercicio(uint8_t n) {
+    sched_stop(exercicio_atual - 1);
+    exercicio_atual = n;
+    sched_agora(n - 1);
+}
+
+// Esvazia a fila contando os eventos de um tipo
+static uint8_t conta_eventos(uint8_t tipo) {
+    botoes_evento_t ev;
+    uint8_t n = 0;
+    while (botoes_evento(&ev)) {
+        if (ev.tipo == tipo) n++;
+    }
+    return n;
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    sched_limpa();
+    setup();
+}
+
+void tearDown() {}
+
+// Ex 3.10: BTN2 → LED2 aceso e "2" no display
+void test_ex3_10_botao2() {
+    botao(BTN2, 1);
+    roda_ms(30);
+    botao(BTN2, 0);
+    roda_ms(30);
+
+    TEST_ASSERT_TRUE(PORTD & Led2::mascara);
+    TEST_ASSERT_EQUAL_HEX8(DIGIT_7SEG[2].c, PORTC & SEG_MASK_C);
+    TEST_ASSERT_EQUAL_HEX8(DIGIT_7SEG[2].d, PORTD & SEG_MASK_D);
+    TEST_ASSERT_EQUAL_HEX8(DIGIT_7SEG[2].b, PORTB & SEG_MASK_B);
+}
+
+// Fora de 0-9: segmento A (estouro), não mais um "0" enganoso
+void test_display_estouro() {
+    atualizar_display(12);
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(DIGIT_7SEG[SEG7_ESTOURO].c, PORTC & SEG_MASK_C);
+    TEST_ASSERT_EQUAL_HEX8(SegA::mascara, PORTC & SEG_MASK_C);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTD & SEG_MASK_D);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTB & SEG_MASK_B);
+}
+
+// Repique mais curto que 4 amostras seguidas não gera evento extra
+void test_debounce_ignora_repique() {
+    const uint8_t repique_ms[] = { 1, 1, 2, 1, 3, 1, 2 };
+
+    for (uint8_t i = 0; i < sizeof(repique_ms); i++) {
+        botao(BTN1, !(i & 1));
+        mock_avanca_ms(repique_ms[i]);
+    }
+    botao(BTN1, 1);
+    mock_avanca_ms(30);
+
+    TEST_ASSERT_TRUE(botoes_estado & (1 << BTN1));
+    TEST_ASSERT_EQUAL_UINT8(1, conta_eventos(EVT_PRESS));
+    TEST_ASSERT_EQUAL_UINT8(0, botoes_perdidos);
+    botao(BTN1, 0);
+}
+
+// Ex 3.1: cada pressão alterna o LED1
+void test_ex3_1_alterna_led() {
+    sched_stop(exercicio_atual - 1);
+    exercicio_atual = 1;
+    sched_agora(0);
+
+    botao(BTN1, 1);
+    roda_ms(30);
+    botao(BTN1, 0);
+    roda_ms(30);
+    TEST_ASSERT_TRUE(PORTD & Led1::mascara);
+
+    botao(BTN1, 1);
+    roda_ms(30);
+    botao(BTN1, 0);
+    roda_ms(30);
+    TEST_ASSERT_FALSE(PORTD & Led1::mascara);
+}
+
+// Voltar ao exercício começa do estado inicial (arena zerada na entrada)
+void test_reentrada_zera_estado() {
+    test_ex3_1_alterna_led();
+    botao(BTN1, 1);
+    roda_ms(30);
+    botao(BTN1, 0);
+    roda_ms(30);
+    TEST_ASSERT_TRUE(ex.ex31.ligado);
+
+    sched_limpa();
+    modulo3_inicia(1);
+    roda_ms(5);
+    TEST_ASSERT_FALSE(ex.ex31.ligado);
+    TEST_ASSERT_FALSE(PORTD & Led1::mascara);
+}
+
+// LONG_PRESS sai uma vez só, botoes_longo_ms depois da pressão aceita
+void test_long_press() {
+    botao(BTN3, 1);
+    mock_avanca_ms(30);
+    TEST_ASSERT_EQUAL_UINT8(1, conta_eventos(EVT_PRESS));
+
+    mock_avanca_ms(botoes_longo_ms - 40);
+    TEST_ASSERT_EQUAL_UINT8(0, conta_eventos(EVT_LONG_PRESS));
+    mock_avanca_ms(1000);
+    TEST_ASSERT_EQUAL_UINT8(1, conta_eventos(EVT_LONG_PRESS));
+
+    botao(BTN3, 0);
+    mock_avanca_ms(30);
+    TEST_ASSERT_EQUAL_UINT8(0, conta_eventos(EVT_CLICK));
+}
+
+// A janela de duplo clique fecha no tick: outro clique 65536ms depois
+// (tick16 deu a volta) não vira DOUBLE_CLICK
+void test_duplo_clique_expira_no_tick() {
+    botao(BTN2, 1);
+    mock_avanca_ms(30);
+    botao(BTN2, 0);
+    mock_avanca_ms(30);
+    TEST_ASSERT_EQUAL_UINT8(1, conta_eventos(EVT_CLICK));
+
+    mock_avanca_ms(65536UL - 60);
+    botao(BTN2, 1);
+    mock_avanca_ms(30);
+    botao(BTN2, 0);
+    mock_avanca_ms(30);
+    TEST_ASSERT_EQUAL_UINT8(0, conta_eventos(EVT_DOUBLE_CLICK));
+}
+
+// Telemetria sai a cada TELEMETRIA_MS sem atrapalhar os exercícios
+// (3.2: o LED pisca, o chip não desliga)
+void test_telemetria_periodica() {
+    telemetria_quadro_t q[4];
+    troca_exercicio(2);
+    roda_ms(2 * TELEMETRIA_MS + 10);
+
+    TEST_ASSERT_EQUAL_UINT16(3 * sizeof(telemetria_quadro_t), mock_uart_tx((uint8_t *)q, sizeof(q)));
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_HEX8(TELEMETRIA_SYNC, q[i].sync);
+        TEST_ASSERT_EQUAL_UINT8(exercicio_atual, q[i].exercicio);
+    }
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(q[0].seq + 2), q[2].seq);
+}
+
+// Ex 3.2: LED1 troca a cada 200ms pelo OC2B; a tarefa não acorda para isso
+void test_ex3_2_pisca_no_oc2b() {
+    sched_stop(exercicio_atual - 1);
+    exercicio_atual = 2;
+    sched_agora(1);
+    roda_ms(1);
+    uint32_t acordou = sched_tarefas[1].wakeups;
+
+    unsigned long bordas[4];
+    uint8_t n = 0;
+    uint8_t ant = READ_BIT(mock_saida_d(), Led1::bit);
+    while (n < 4) {
+        roda_ms(1);
+        uint8_t v = READ_BIT(mock_saida_d(), Led1::bit);
+        if (v != ant) bordas[n++] = millis_custom();
+        ant = v;
+    }
+    for (uint8_t i = 1; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT32(200, bordas[i] - bordas[i - 1]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(acordou, sched_tarefas[1].wakeups);
+}
+
+// Ex 3.9: BTN1 acende os 4 LEDs (PORTB e PORTD) com uma escrita por porta,
+// depois da janela do acorde; passos sem mudança não escrevem nada
+void test_ex3_9_um_commit_por_porta() {
+    sched_stop(exercicio_atual - 1);
+    exercicio_atual = 9;
+    sched_agora(8);
+    roda_ms(5);
+    uint16_t antes = sombra_escritas;
+
+    botao(BTN1, 1);
+    roda_ms(30 + M3_JANELA_ACORDE_MS);
+    TEST_ASSERT_EQUAL_HEX8(Leds::mascara<PortD>(), PORTD & Leds::mascara<PortD>());
+    TEST_ASSERT_EQUAL_HEX8(Leds::mascara<PortB>(), PORTB & Leds::mascara<PortB>());
+    TEST_ASSERT_EQUAL_UINT16(antes + 2, sombra_escritas);
+
+    roda_ms(100);
+    TEST_ASSERT_EQUAL_UINT16(antes + 2, sombra_escritas);
+    botao(BTN1, 0);
+}
+
+// exercicio_atual escrito por fora antes do 1º loop() (como o bench): a
+// tarefa do 3.10, armada no setup(), não roda sobre a arena do 3.2 nem
+// apaga o pisca que entra_exercicio() armou
+void test_troca_por_fora_arma_o_novo() {
+    uint16_t w = sched_tarefas[9].wakeups;
+    exercicio_atual = 2;
+    roda_ms(50);
+    TEST_ASSERT_TRUE(led_ativo());
+    TEST_ASSERT_EQUAL_UINT16(w, sched_tarefas[9].wakeups);
+    TEST_ASSERT_TRUE(sched_tarefas[1].wakeups > 0);
+}
+
+// Ex 3.9: BTN3 chega 10ms depois do BTN1 e solta 10ms depois dele. Nem
+// "todos acesos" (BTN1) nem LED3/LED4 (BTN3) aparecem: só o acorde (apaga)
+void test_ex3_9_acorde_sem_acao_intermediaria() {
+    troca_exercicio(9);
+    roda_ms(5);
+    uint16_t antes = sombra_escritas;
+
+    botao(BTN1, 1);
+    roda_ms(10);
+    botao(BTN3, 1);
+    for (uint8_t i = 0; i < 100; i++) {
+        roda_ms(1);
+        TEST_ASSERT_EQUAL_HEX8(0, PORTB & Leds::mascara<PortB>());
+        TEST_ASSERT_EQUAL_HEX8(0, PORTD & Leds::mascara<PortD>());
+    }
+    botao(BTN1, 0);
+    roda_ms(10);
+    botao(BTN3, 0);
+    for (uint8_t i = 0; i < 100; i++) {
+        roda_ms(1);
+        TEST_ASSERT_EQUAL_HEX8(0, PORTB & Leds::mascara<PortB>());
+    }
+    TEST_ASSERT_EQUAL_UINT16(antes, sombra_escritas);
+
+    // BTN3 sozinho: LED3 e LED4 quando a janela fecha
+    botao(BTN3, 1);
+    roda_ms(25);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTB & Leds::mascara<PortB>());
+    roda_ms(M3_JANELA_ACORDE_MS);
+    TEST_ASSERT_EQUAL_HEX8(Leds::mascara<PortB>(), PORTB & Leds::mascara<PortB>());
+    botao(BTN3, 0);
+}
+
+// Ex 3.1 parado: POWER_DOWN (timers parados, ms congelado) até a borda do
+// botão; depois da janela de duplo clique volta a desligar
+void test_ex3_1_power_down_ate_o_botao() {
+    troca_exercicio(1);
+    roda_ms(50);
+    uint32_t desligou = mock_desligadas();
+    TEST_ASSERT_TRUE(desligou > 0);
+    unsigned long ms = millis_custom();
+    roda_ms(1000);
+    TEST_ASSERT_EQUAL_UINT32(ms, millis_custom());
+    TEST_ASSERT_EQUAL_HEX8(ENERGIA_SEM_USO, PRR);
+
+    botao(BTN1, 1);
+    roda_ms(30);
+    botao(BTN1, 0);
+    roda_ms(30);
+    TEST_ASSERT_TRUE(PORTD & Led1::mascara);
+    TEST_ASSERT_TRUE(millis_custom() - ms >= 60);
+
+    desligou = mock_desligadas();
+    roda_ms(botoes_duplo_ms + 50);
+    TEST_ASSERT_TRUE(mock_desligadas() > desligou);
+    TEST_ASSERT_TRUE(PORTD & Led1::mascara);
+}
+
+// Pisca-pisca ou botão segurado precisam do tick: só IDLE
+void test_sem_power_down_com_pisca_ou_botao() {
+    troca_exercicio(2);
+    roda_ms(500);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_desligadas());
+
+    troca_exercicio(6);
+    botao(BTN1, 1);
+    roda_ms(500);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_desligadas());
+    TEST_ASSERT_TRUE(PORTD & Led1::mascara);
+    botao(BTN1, 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ex3_10_botao2);
+    RUN_TEST(test_display_estouro);
+    RUN_TEST(test_debounce_ignora_repique);
+    RUN_TEST(test_ex3_1_alterna_led);
+    RUN_TEST(test_reentrada_zera_estado);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_duplo_clique_expira_no_tick);
+    RUN_TEST(test_telemetria_periodica);
+    RUN_TEST(test_ex3_2_pisca_no_oc2b);
+    RUN_TEST(test_ex3_9_um_commit_por_porta);
+    RUN_TEST(test_ex3_9_acorde_sem_acao_intermediaria);
+    RUN_TEST(test_troca_por_fora_arma_o_novo);
+    RUN_TEST(test_ex3_1_power_down_ate_o_botao);
+    RUN_TEST(test_sem_power_down_com_pisca_ou_botao);
+    return UNITY_END();
+}
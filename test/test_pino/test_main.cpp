@@ -0,0 +1,94 @@
+/*
+ * ================================================================================
+ * TESTES - PINO (Pin / PinGroup)
+ * ================================================================================
+ * As máscaras e o espalhamento são constexpr: parte da conferência é
+ * static_assert. O resto olha os registradores do mock e, nos pinos em
+ * Sombra<>, as cópias e sombra_escritas.
+ */
+
+#include <unity.h>
+#include <avr/io.h>
+#include "mock_avr.h"
+#include "pino.h"
+
+typedef Pin<PortB, PB3> Direto;
+typedef Pin<Sombra<PortD>, PD7> D7;
+typedef Pin<Sombra<PortD>, PD2> D2;
+typedef Pin<Sombra<PortC>, PC1> C1;
+typedef PinGroup<D7, C1, D2> Grupo;     // Bit 0 → PD7, bit 1 → PC1, bit 2 → PD2
+
+static_assert(Grupo::mascara<PortD>() == 0x84, "máscara de PORTD");
+static_assert(Grupo::mascara<PortC>() == 0x02, "máscara de PORTC");
+static_assert(Grupo::mascara<PortB>() == 0, "sem pinos em PORTB");
+static_assert(Grupo::espalha<PortD>(0b101) == 0x84, "bits 0 e 2 em PD7 e PD2");
+static_assert(Grupo::espalha<PortC>(0b010) == 0x02, "bit 1 em PC1");
+static_assert(C1::id == SOMBRA_PINO(SOMBRA_C, 1), "mesma numeração de SOMBRA_PINO");
+
+void setUp() {
+    mock_reset();
+    sombra_inicia(0, 0x02, 0x84);
+}
+
+void tearDown() {
+    sombra_para();
+}
+
+// Pino direto: só o próprio bit de PORTB/DDRB/PINB
+void test_pino_direto() {
+    PORTB = 0x81;
+    Direto::output();
+    Direto::set();
+    TEST_ASSERT_EQUAL_HEX8(0x08, DDRB);
+    TEST_ASSERT_EQUAL_HEX8(0x89, PORTB);
+    Direto::tgl();
+    TEST_ASSERT_EQUAL_HEX8(0x81, PORTB);
+    Direto::write(5);
+    TEST_ASSERT_EQUAL_HEX8(0x89, PORTB);
+
+    PINB = 0x08;
+    TEST_ASSERT_EQUAL_UINT8(1, Direto::read());
+    PINB = 0xF7;
+    TEST_ASSERT_EQUAL_UINT8(0, Direto::read());
+}
+
+// Grupo em Sombra<>: escreve as cópias, as portas mudam no commit
+// (uma escrita por porta)
+void test_grupo_uma_escrita_por_porta() {
+    uint16_t antes = sombra_escritas;
+    PORTD = 0x01;
+    sombra_sincroniza();
+
+    Grupo::write(0b111);
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x85, SOMBRA_PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x02, SOMBRA_PORTC);
+
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x85, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x02, PORTC);
+    TEST_ASSERT_EQUAL_UINT16(antes + 2, sombra_escritas);
+
+    Grupo::write(0b100);
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x05, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x00, PORTC);
+
+    Grupo::set();
+    Grupo::output();
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x85, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x84, DDRD);
+    TEST_ASSERT_EQUAL_HEX8(0x02, DDRC);
+
+    Grupo::clr();
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTD);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pino_direto);
+    RUN_TEST(test_grupo_uma_escrita_por_porta);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+/*
+ * ================================================================================
+ * TESTES - TEMPORIZADOR PERIÓDICO (sched_per_t) E SUAS POLÍTICAS
+ * ================================================================================
+ * Uma tarefa atrasa de propósito (mock_avanca_ms dentro dela) e o teste
+ * confere onde cai o próximo deadline e o que entra nas estatísticas.
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "timebase.h"
+#include "scheduler.h"
+
+static sched_per_t per;
+static uint8_t tarefa;
+static uint8_t disparos;
+static uint16_t atraso_ms;          // Atraso injetado no próximo disparo
+static uint8_t ociosas;             // Chamadas de sched_ocioso_hook()
+static uint8_t ocioso_dorme;        // 1 = o hook "dorme" (só religa o bit I)
+
+uint8_t sched_ocioso_hook() {
+    ociosas++;
+    if (!ocioso_dorme) return 0;
+    sei();
+    return 1;
+}
+
+static void periodica() {
+    if (sched_per_venceu(&per)) {
+        disparos++;
+        mock_avanca_ms(atraso_ms);
+        atraso_ms = 0;
+    }
+    sched_next_at(per.proximo);
+}
+
+static void roda_ate(unsigned long t) {
+    while ((long)(millis_custom() - t) < 0) sched_run();
+}
+
+static void inicia(uint8_t politica) {
+    sched_per_inicia(&per, 100, politica);
+    sched_at(tarefa, per.proximo);
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    sched_limpa();
+    timer1_init();
+    tarefa = sched_add(periodica);
+    disparos = 0;
+    atraso_ms = 0;
+    ociosas = 0;
+    ocioso_dorme = 0;
+}
+
+void tearDown() {}
+
+// Atraso menor que um período não empurra os disparos seguintes
+void test_atraso_curto_nao_acumula() {
+    inicia(SCHED_RESSINC);
+    atraso_ms = 60;
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_UINT8(10, disparos);
+    TEST_ASSERT_EQUAL_UINT16(1100, per.proximo);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_deriva);
+}
+
+// 250ms presos no disparo de 100: o de 200 sai atrasado (350), o de 300 é
+// descartado e a fase continua nos múltiplos de 100
+void test_pula_mantem_a_fase() {
+    inicia(SCHED_PULA);
+    atraso_ms = 250;
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_UINT8(9, disparos);
+    TEST_ASSERT_EQUAL_UINT16(1100, per.proximo);
+    TEST_ASSERT_EQUAL_UINT16(1, sched_tarefas[tarefa].perdidos);
+    TEST_ASSERT_EQUAL_UINT16(0, sched_tarefas[tarefa].deriva);
+}
+
+// Exatamente um período atrasado: o disparo de 200 sai em 300, junto com
+// o de 300, que não conta como perdido em nenhuma política
+void test_um_periodo_de_atraso_nao_perde() {
+    inicia(SCHED_PULA);
+    atraso_ms = 200;
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_UINT8(10, disparos);
+    TEST_ASSERT_EQUAL_UINT16(1100, per.proximo);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_perdidos);
+
+    sched_limpa();
+    tarefa = sched_add(periodica);
+    disparos = 0;
+    inicia(SCHED_RESSINC);
+    atraso_ms = 200;
+    roda_ate(2002);                 // Começou em 1001
+    TEST_ASSERT_EQUAL_UINT8(10, disparos);
+    TEST_ASSERT_EQUAL_UINT16(2101, per.proximo);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_perdidos);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_deriva);
+}
+
+// Rajada: os disparos atrasados saem em seguida, nenhum se perde
+void test_rajada_alcanca() {
+    inicia(SCHED_RAJADA);
+    atraso_ms = 250;
+    roda_ate(351);
+    TEST_ASSERT_EQUAL_UINT8(3, disparos);
+    TEST_ASSERT_EQUAL_UINT16(400, per.proximo);
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_UINT8(10, disparos);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_perdidos);
+}
+
+// Ressincroniza: o disparo de 200 sai em 350 e a contagem recomeça dali;
+// os 150ms de atraso viram deriva
+void test_ressinc_conta_deriva() {
+    inicia(SCHED_RESSINC);
+    atraso_ms = 250;
+    roda_ate(1001);
+    TEST_ASSERT_EQUAL_UINT16(1050, per.proximo);
+    TEST_ASSERT_EQUAL_UINT16(150, sched_tarefas[tarefa].deriva);
+    TEST_ASSERT_EQUAL_UINT32(150, sched_deriva);
+}
+
+// Deadline de tarefa comum segura o IDLE; de fundo deixa o hook decidir
+void test_hook_ocioso_so_com_tarefas_de_fundo() {
+    inicia(SCHED_PULA);
+    roda_ate(250);
+    TEST_ASSERT_EQUAL_UINT8(0, ociosas);
+    TEST_ASSERT_EQUAL_UINT8(2, disparos);
+
+    sched_fundo(tarefa);
+    roda_ate(280);
+    TEST_ASSERT_TRUE(ociosas > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, sched_desligadas);
+
+    ocioso_dorme = 1;
+    unsigned long dormidas = sched_dormidas;
+    sched_run();
+    TEST_ASSERT_EQUAL_UINT32(1, sched_desligadas);
+    TEST_ASSERT_EQUAL_UINT32(dormidas + 1, sched_dormidas);
+    TEST_ASSERT_TRUE(SREG & (1 << SREG_I));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_atraso_curto_nao_acumula);
+    RUN_TEST(test_pula_mantem_a_fase);
+    RUN_TEST(test_um_periodo_de_atraso_nao_perde);
+    RUN_TEST(test_rajada_alcanca);
+    RUN_TEST(test_ressinc_conta_deriva);
+    RUN_TEST(test_hook_ocioso_so_com_tarefas_de_fundo);
+    return UNITY_END();
+}
@@ -0,0 +1,93 @@
+/*
+ * ================================================================================
+ * TESTES - SEG7 (VALOR → GLIFOS, SEM DIVISÃO)
+ * ================================================================================
+ * Só lógica: os glifos são comparados com strings em que '0'-'9'/'A'-'F' são
+ * dígitos, ' ' apagado, '-' o sinal, '^' e '_' os estouros.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "seg7.h"
+
+static char texto[SEG7_DIGITOS_MAX + 2];
+
+static const char *mostra(const uint8_t *dig, uint8_t n) {
+    static const char GLIFO[SEG7_N + 1] = "0123456789ABCDEF -^_";
+    for (uint8_t i = 0; i < n; i++) texto[i] = GLIFO[dig[i]];
+    texto[n] = 0;
+    return texto;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Todos os 65536 valores contra / e %
+void test_bcd16_igual_a_divisao() {
+    uint8_t d[SEG7_DIGITOS_MAX];
+    for (uint32_t v = 0; v <= 0xFFFF; v++) {
+        seg7_bcd16((uint16_t)v, d);
+        uint32_t r = v;
+        for (uint8_t i = 0; i < SEG7_DIGITOS_MAX; i++, r /= 10) {
+            if (d[i] != r % 10) TEST_FAIL_MESSAGE("dígito errado");
+        }
+    }
+}
+
+void test_decimal_sem_zeros_a_esquerda() {
+    uint8_t dig[4];
+    TEST_ASSERT_EQUAL_UINT8(0, seg7_u16(dig, 4, 0, SEG7_DEC));
+    TEST_ASSERT_EQUAL_STRING("   0", mostra(dig, 4));
+    seg7_u16(dig, 4, 905, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING(" 905", mostra(dig, 4));
+    seg7_u16(dig, 4, 42, SEG7_ZEROS);
+    TEST_ASSERT_EQUAL_STRING("0042", mostra(dig, 4));
+    seg7_u8(dig, 4, 255, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING(" 255", mostra(dig, 4));
+}
+
+void test_sinal_junto_do_numero() {
+    uint8_t dig[SEG7_DIGITOS_MAX + 1];
+    seg7_s16(dig, 4, -7, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING("  -7", mostra(dig, 4));
+    seg7_s16(dig, 4, -7, SEG7_ZEROS);
+    TEST_ASSERT_EQUAL_STRING("-007", mostra(dig, 4));
+    seg7_s8(dig, 4, -128, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING("-128", mostra(dig, 4));
+    seg7_s16(dig, 6, -32768, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING("-32768", mostra(dig, 6));
+    seg7_s16(dig, 2, 9, SEG7_DEC);
+    TEST_ASSERT_EQUAL_STRING(" 9", mostra(dig, 2));
+}
+
+void test_hexa() {
+    uint8_t dig[4];
+    seg7_u16(dig, 4, 0xBEEF, SEG7_HEX);
+    TEST_ASSERT_EQUAL_STRING("BEEF", mostra(dig, 4));
+    seg7_u8(dig, 4, 0x0A, SEG7_HEX);
+    TEST_ASSERT_EQUAL_STRING("   A", mostra(dig, 4));
+    seg7_s8(dig, 4, -0x10, SEG7_HEX | SEG7_ZEROS);
+    TEST_ASSERT_EQUAL_STRING("-010", mostra(dig, 4));
+}
+
+// Não coube: todos os dígitos com o glifo de estouro
+void test_estouro() {
+    uint8_t dig[4];
+    TEST_ASSERT_EQUAL_UINT8(1, seg7_u16(dig, 4, 10000, SEG7_DEC));
+    TEST_ASSERT_EQUAL_STRING("^^^^", mostra(dig, 4));
+    TEST_ASSERT_EQUAL_UINT8(1, seg7_s16(dig, 4, -1000, SEG7_DEC));
+    TEST_ASSERT_EQUAL_STRING("____", mostra(dig, 4));
+    TEST_ASSERT_EQUAL_UINT8(0, seg7_s16(dig, 4, -999, SEG7_DEC));
+    TEST_ASSERT_EQUAL_UINT8(1, seg7_u8(dig, 1, 0x10, SEG7_HEX));
+    TEST_ASSERT_EQUAL_STRING("^", mostra(dig, 1));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bcd16_igual_a_divisao);
+    RUN_TEST(test_decimal_sem_zeros_a_esquerda);
+    RUN_TEST(test_sinal_junto_do_numero);
+    RUN_TEST(test_hexa);
+    RUN_TEST(test_estouro);
+    return UNITY_END();
+}
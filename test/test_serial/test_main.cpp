@@ -0,0 +1,94 @@
+/*
+ * ================================================================================
+ * TESTES - SERIAL (FILA TX + ISR UDRE) E QUADRO DE TELEMETRIA
+ * ================================================================================
+ */
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "timebase.h"
+#include "scheduler.h"
+#include "serial.h"
+#include "telemetria.h"
+
+#define US_POR_BYTE     (10 * 1000000UL / SERIAL_BAUD)
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    sched_limpa();
+    timer1_init();
+    serial_init();
+}
+
+void tearDown() {}
+
+// serial_envia() só enfileira; os bytes saem no ritmo do baud
+void test_envia_sem_bloquear() {
+    const uint8_t msg[4] = { 'a', 'b', 'c', 'd' };
+    uint8_t rx[8];
+
+    TEST_ASSERT_EQUAL_UINT8(1, serial_envia(msg, sizeof(msg)));
+    TEST_ASSERT_EQUAL_UINT16(0, mock_uart_tx(rx, sizeof(rx)));
+    mock_avanca_us(1);
+    TEST_ASSERT_EQUAL_UINT16(1, mock_uart_tx(rx, sizeof(rx)));   // 1º byte direto no UDR0
+    mock_avanca_us(2 * US_POR_BYTE);
+    TEST_ASSERT_EQUAL_UINT16(2, mock_uart_tx(rx + 1, sizeof(rx) - 1));
+    mock_avanca_us(2 * US_POR_BYTE);
+    TEST_ASSERT_EQUAL_UINT16(1, mock_uart_tx(rx + 3, sizeof(rx) - 3));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(msg, rx, sizeof(msg));
+    TEST_ASSERT_FALSE(UCSR0B & (1 << UDRIE0));                   // Fila vazia → ISR desligada
+}
+
+// Mensagem que não cabe é descartada inteira
+void test_fila_cheia_descarta_a_mensagem() {
+    uint8_t bloco[SERIAL_TX_N / 2];
+    for (uint8_t i = 0; i < sizeof(bloco); i++) bloco[i] = i;
+
+    cli();
+    TEST_ASSERT_EQUAL_UINT8(1, serial_envia(bloco, sizeof(bloco)));
+    TEST_ASSERT_EQUAL_UINT8(0, serial_envia(bloco, sizeof(bloco)));
+    TEST_ASSERT_EQUAL_UINT8(1, serial_descartados);
+    TEST_ASSERT_EQUAL_UINT8(SERIAL_TX_N - 1 - sizeof(bloco), serial_livre());
+    sei();
+}
+
+void test_quadro_de_telemetria() {
+    telemetria_quadro_t q;
+    PORTB = 0x12;
+    PORTC = 0x34;
+    PORTD = 0x56;
+
+    TEST_ASSERT_EQUAL_UINT8(1, telemetria_envia(7, 0x1C));
+    mock_avanca_us(sizeof(q) * US_POR_BYTE);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(q), mock_uart_tx((uint8_t *)&q, sizeof(q)));
+
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRIA_SYNC, q.sync);
+    TEST_ASSERT_EQUAL_UINT8(7, q.exercicio);
+    TEST_ASSERT_EQUAL_HEX8(0x12, q.portb);
+    TEST_ASSERT_EQUAL_HEX8(0x34, q.portc);
+    TEST_ASSERT_EQUAL_HEX8(0x56, q.portd);
+    TEST_ASSERT_EQUAL_HEX8(0x1C, q.botoes);
+
+    uint8_t x = 0;
+    for (uint8_t i = 0; i < sizeof(q); i++) x ^= ((uint8_t *)&q)[i];
+    TEST_ASSERT_EQUAL_HEX8(0, x);
+}
+
+void test_leitura_por_polling() {
+    uint8_t c = 0;
+    TEST_ASSERT_EQUAL_UINT8(0, serial_le(&c));
+    mock_uart_rx('d');
+    TEST_ASSERT_EQUAL_UINT8(1, serial_le(&c));
+    TEST_ASSERT_EQUAL_UINT8('d', c);
+    TEST_ASSERT_EQUAL_UINT8(0, serial_le(&c));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_envia_sem_bloquear);
+    RUN_TEST(test_fila_cheia_descarta_a_mensagem);
+    RUN_TEST(test_quadro_de_telemetria);
+    RUN_TEST(test_leitura_por_polling);
+    return UNITY_END();
+}
@@ -0,0 +1,76 @@
+/*
+ * ================================================================================
+ * TESTES - SOMBRA (CÓPIAS DAS PORTAS + COMMIT MASCARADO)
+ * ================================================================================
+ * Só registradores do mock: o commit é conferido pelo valor final das
+ * portas e pelo número de escritas (sombra_escritas).
+ */
+
+#include <unity.h>
+#include <avr/io.h>
+#include "mock_avr.h"
+#include "modulo.h"
+#include "sombra.h"
+
+void setUp() {
+    mock_reset();
+    sombra_inicia(0x0F, 0x01, 0x18);
+}
+
+void tearDown() {
+    sombra_para();
+}
+
+// Só o estado final chega às portas, uma escrita por porta que mudou
+void test_commit_so_do_que_mudou() {
+    uint16_t antes = sombra_escritas;
+    SOMBRA_PORTD = 0;
+    SET_BIT(SOMBRA_PORTD, 3);
+    CLR_BIT(SOMBRA_PORTD, 3);
+    SET_BIT(SOMBRA_PORTD, 4);
+    SET_BIT(SOMBRA_PORTB, 0);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTD);
+
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x10, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTB);
+    TEST_ASSERT_EQUAL_UINT16(antes + 2, sombra_escritas);
+
+    sombra_commit();
+    TEST_ASSERT_EQUAL_UINT16(antes + 2, sombra_escritas);
+}
+
+// Bits fora da máscara ficam com quem os escreveu direto
+void test_bits_de_fora_intactos() {
+    PORTB = 0x80;
+    SOMBRA_PORTB = 0x03;
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x83, PORTB);
+
+    // Sem sincronizar, a cópia não sabe do PB7; ele continua igual
+    PORTB |= 0x40;
+    CLR_BIT(SOMBRA_PORTB, 1);
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0xC1, PORTB);
+}
+
+// Espelho: pino virtual (PB3) sai também em PC0 no mesmo commit
+void test_espelho_no_commit() {
+    sombra_espelho(SOMBRA_PINO(SOMBRA_B, 3), SOMBRA_PINO(SOMBRA_C, 0));
+    SET_BIT(SOMBRA_PORTB, 3);
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x08, PORTB);
+    TEST_ASSERT_EQUAL_HEX8(0x01, PORTC);
+
+    CLR_BIT(SOMBRA_PORTB, 3);
+    sombra_commit();
+    TEST_ASSERT_EQUAL_HEX8(0x00, PORTC);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_commit_so_do_que_mudou);
+    RUN_TEST(test_bits_de_fora_intactos);
+    RUN_TEST(test_espelho_no_commit);
+    return UNITY_END();
+}
@@ -0,0 +1,93 @@
+/*
+ * ================================================================================
+ * TESTES - TIMEBASE (Timer1 1ms sobre o relógio virtual)
+ * ================================================================================
+ */
+
+#include <unity.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "mock_avr.h"
+#include "timebase.h"
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    timer1_init();
+}
+
+void tearDown() {}
+
+void test_millis_conta_1_por_ms() {
+    mock_avanca_ms(1);
+    TEST_ASSERT_EQUAL_UINT32(1, millis_custom());
+    mock_avanca_ms(999);
+    TEST_ASSERT_EQUAL_UINT32(1000, millis_custom());
+}
+
+void test_micros_resolucao_4us() {
+    mock_avanca_us(2);
+    TEST_ASSERT_EQUAL_UINT32(0, micros_custom());
+    mock_avanca_us(2);
+    TEST_ASSERT_EQUAL_UINT32(4, micros_custom());
+    mock_avanca_us(1000);
+    TEST_ASSERT_EQUAL_UINT32(1004, micros_custom());
+}
+
+// Com interrupções desligadas o ms vencido fica pendente em OCF1A:
+// micros_custom() tem que contá-lo mesmo assim (sem voltar no tempo)
+void test_micros_com_tick_pendente() {
+    mock_avanca_us(996);
+    cli();
+    unsigned long antes = micros_custom();
+    mock_avanca_us(8);
+    unsigned long depois = micros_custom();
+    TEST_ASSERT_EQUAL_UINT32(996, antes);
+    TEST_ASSERT_EQUAL_UINT32(1004, depois);
+    TEST_ASSERT_EQUAL_UINT32(0, timer_millis);
+    sei();
+    mock_avanca_us(1);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_millis);
+}
+
+void test_millis_preserva_bit_i() {
+    cli();
+    millis_custom();
+    TEST_ASSERT_FALSE(SREG & (1 << SREG_I));
+    sei();
+    millis_custom();
+    TEST_ASSERT_TRUE(SREG & (1 << SREG_I));
+}
+
+void test_delay_ms_dorme_entre_ticks() {
+    uint32_t dormidas = mock_dormidas();
+    delay_ms(50);
+    TEST_ASSERT_EQUAL_UINT32(50, millis_custom());
+    TEST_ASSERT_EQUAL_UINT32(50, mock_dormidas() - dormidas);
+}
+
+// tick16() = 16 bits baixos de millis_custom(); comparações seguras no wrap
+void test_tick16_atravessa_wrap() {
+    timer_millis = 0x1FFF8;
+    tick16_t t = tick16();
+    TEST_ASSERT_EQUAL_UINT16(0xFFF8, t);
+    mock_avanca_ms(9);
+    TEST_ASSERT_FALSE(tick16_passou(t, 10));
+    mock_avanca_ms(1);
+    TEST_ASSERT_EQUAL_UINT16(2, tick16());
+    TEST_ASSERT_TRUE(tick16_passou(t, 10));
+    TEST_ASSERT_TRUE(tick16_venceu(tick16(), t + 10));
+    TEST_ASSERT_FALSE(tick16_venceu(tick16(), t + 11));
+    TEST_ASSERT_EQUAL_INT16(-10, tick16_dif(t, tick16()));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_millis_conta_1_por_ms);
+    RUN_TEST(test_micros_resolucao_4us);
+    RUN_TEST(test_micros_com_tick_pendente);
+    RUN_TEST(test_millis_preserva_bit_i);
+    RUN_TEST(test_delay_ms_dorme_entre_ticks);
+    RUN_TEST(test_tick16_atravessa_wrap);
+    return UNITY_END();
+}
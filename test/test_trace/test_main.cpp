@@ -0,0 +1,65 @@
+/*
+ * ================================================================================
+ * TESTES - TRACE (buffer circular com carimbo tick + TCNT1)
+ * ================================================================================
+ * O ambiente native compila as libs com TRACE_ATIVO=0; aqui a implementação
+ * é incluída com o trace ligado.
+ */
+
+#define TRACE_ATIVO 1
+
+#include <unity.h>
+#include "mock_avr.h"
+#include "../../lib/trace/trace.cpp"
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    timer1_init();
+    trace_pos = 0;
+    trace_pausado = 0;
+}
+
+void tearDown() {}
+
+void test_carimbo_tick_e_tcnt() {
+    mock_avanca_us(3020);
+    TRACE(TRACE_PORTB);
+
+    TEST_ASSERT_EQUAL_UINT8(1, trace_pos);
+    TEST_ASSERT_EQUAL_HEX8(TRACE_PORTB, trace_buf[0].id);
+    TEST_ASSERT_EQUAL_UINT16(3, trace_buf[0].tick);
+    TEST_ASSERT_EQUAL_UINT16(20 / TIMEBASE_US_TICK, trace_buf[0].tcnt);
+}
+
+void test_buffer_guarda_os_mais_recentes() {
+    for (uint16_t i = 0; i < TRACE_N + 3; i++) TRACE((uint8_t)i);
+
+    TEST_ASSERT_EQUAL_UINT8(3, trace_pos);
+    TEST_ASSERT_EQUAL_HEX8(TRACE_N + 2, trace_buf[2].id);
+    TEST_ASSERT_EQUAL_HEX8(3, trace_buf[3].id);
+}
+
+void test_trace_preserva_bit_i() {
+    cli();
+    TRACE(TRACE_BOTOES);
+    TEST_ASSERT_FALSE(SREG & (1 << SREG_I));
+    sei();
+    TRACE(TRACE_BOTOES);
+    TEST_ASSERT_TRUE(SREG & (1 << SREG_I));
+}
+
+void test_pausado_nao_registra() {
+    trace_pausado = 1;
+    TRACE(TRACE_T1_ISR);
+    TEST_ASSERT_EQUAL_UINT8(0, trace_pos);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_carimbo_tick_e_tcnt);
+    RUN_TEST(test_buffer_guarda_os_mais_recentes);
+    RUN_TEST(test_trace_preserva_bit_i);
+    RUN_TEST(test_pausado_nao_registra);
+    return UNITY_END();
+}
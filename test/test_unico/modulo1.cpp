@@ -0,0 +1,3 @@
+// Um arquivo por módulo, como no ambiente "unico"
+#define FIRMWARE_UNICO
+#include "../../modulos/modulo1_leds.cpp"
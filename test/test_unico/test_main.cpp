@@ -0,0 +1,150 @@
+/*
+ * ================================================================================
+ * TESTES - FIRMWARE ÚNICO (TROCA DE MÓDULO EM TEMPO DE EXECUÇÃO)
+ * ================================================================================
+ * Os três módulos são compilados em arquivos separados com FIRMWARE_UNICO
+ * (modulo1.cpp, modulo2.cpp, modulo3.cpp); aqui só entra o setup()/loop()
+ * do firmware. Os exercícios são escolhidos pela serial (mock_uart_rx).
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "mock_avr.h"
+#include "../../modulos/firmware_unico.cpp"
+#include "telemetria.h"
+
+extern volatile uint8_t display_fb[];     // Framebuffer do Módulo 2
+
+static void roda_ms(unsigned long ms) {
+    unsigned long fim = millis_custom() + ms;
+    while ((long)(millis_custom() - fim) < 0) loop();
+}
+
+static void comando_serial(uint8_t c) {
+    mock_uart_rx(c);
+    roda_ms(5);
+}
+
+void setUp() {
+    mock_reset();
+    timer_millis = 0;
+    modulo_atual = modulo_t();
+    setup();
+}
+
+void tearDown() {}
+
+// Liga no 1.1: PORTB inteiro + PC0/PC5, pull-ups desligados, Timer2 parado
+void test_comeca_no_modulo1() {
+    roda_ms(10);
+    TEST_ASSERT_EQUAL_UINT8(0, exercicio_global);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, DDRB);
+    TEST_ASSERT_EQUAL_HEX8((1 << PC0) | (1 << PC5), DDRC);
+    TEST_ASSERT_TRUE(MCUCR & (1 << PUD));
+    TEST_ASSERT_EQUAL_HEX8(0, TIMSK2);
+}
+
+// 'k' → Módulo 2: pinos do Módulo 1 soltos, Timer2 varrendo os dígitos
+void test_troca_para_modulo2() {
+    comando_serial('k');
+    TEST_ASSERT_EQUAL_UINT8(10, exercicio_global);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, DDRB);
+    TEST_ASSERT_EQUAL_HEX8((1 << PC0) | (1 << PC1), DDRC);
+    TEST_ASSERT_FALSE(MCUCR & (1 << PUD));
+    TEST_ASSERT_TRUE(TIMSK2 & (1 << OCIE2A));
+
+    uint8_t antes = display_fb[0];
+    roda_ms(450);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(antes + 2), display_fb[0]);
+}
+
+// 'u' → 3.10: botões com pull-up + PCINT1; BTN2 (PC3) acende LED2 (PD4)
+void test_troca_para_modulo3_e_volta() {
+    comando_serial('k');
+    comando_serial('u');
+    TEST_ASSERT_EQUAL_HEX8(0, TIMSK2);
+    TEST_ASSERT_EQUAL_HEX8(0x1C, PORTC & 0x1C);
+    TEST_ASSERT_TRUE(PCICR & (1 << PCIE1));
+
+    mock_pinc(PINC & ~(1 << PC3));
+    roda_ms(30);
+    mock_pinc(PINC | (1 << PC3));
+    roda_ms(30);
+    TEST_ASSERT_TRUE(PORTD & (1 << PD4));
+
+    // De volta ao 1.1: nada do Módulo 3 fica acionado
+    comando_serial('a');
+    TEST_ASSERT_EQUAL_HEX8(0, DDRD);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTD);
+    TEST_ASSERT_EQUAL_HEX8(0, PORTC & 0x1C);
+    TEST_ASSERT_FALSE(PCICR & (1 << PCIE1));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, DDRB);
+}
+
+// A troca não reinicia a serial nem o Timer1: o que estava na fila sai
+// e o ms em curso continua
+void test_troca_preserva_serial_e_timer1() {
+    uint8_t buf[128];
+    roda_ms(10);
+    mock_uart_tx(buf, sizeof(buf));
+
+    static const uint8_t msg[] = { 'O', 'L', 'A', '!' };
+    TEST_ASSERT_EQUAL_UINT8(1, serial_envia(msg, sizeof(msg)));
+    mock_avanca_us(100);
+    uint16_t tcnt = TCNT1;
+    seleciona_exercicio(11);
+    TEST_ASSERT_EQUAL_UINT16(tcnt, TCNT1);
+
+    roda_ms(5);
+    uint16_t n = mock_uart_tx(buf, sizeof(buf));
+    uint8_t achou = 0;
+    for (uint16_t i = 0; i + sizeof(msg) <= n; i++) {
+        if (!memcmp(&buf[i], msg, sizeof(msg))) achou = 1;
+    }
+    TEST_ASSERT_TRUE(achou);
+}
+
+// Os contadores do escalonador zeram na troca: o primeiro quadro de
+// telemetria do 3.10 conta desde a troca, sem delta negativo (65xxx)
+void test_telemetria_depois_da_troca() {
+    uint8_t buf[256];
+    roda_ms(600);
+    mock_uart_tx(buf, sizeof(buf));
+    comando_serial('u');
+    roda_ms(300);
+
+    uint16_t n = mock_uart_tx(buf, sizeof(buf));
+    uint8_t quadros = 0;
+    for (uint16_t i = 0; i + sizeof(telemetria_quadro_t) <= n; i++) {
+        telemetria_quadro_t q;
+        memcpy(&q, &buf[i], sizeof(q));
+        uint8_t x = 0;
+        for (uint8_t k = 0; k < sizeof(q) - 1; k++) x ^= buf[i + k];
+        if (q.sync != TELEMETRIA_SYNC || q.exercicio != 10 || x != q.xor_) continue;
+        TEST_ASSERT_TRUE(q.execucoes < 1000);
+        TEST_ASSERT_TRUE(q.dormidas < 1000);
+        TEST_ASSERT_EQUAL_UINT16(0, q.perdidos);
+        TEST_ASSERT_EQUAL_UINT16(0, q.deriva);
+        quadros++;
+    }
+    TEST_ASSERT_TRUE(quadros >= 1);
+}
+
+// '-' no primeiro exercício dá a volta para o último (3.10)
+void test_anterior_da_volta() {
+    comando_serial('-');
+    TEST_ASSERT_EQUAL_UINT8(20, exercicio_global);
+    comando_serial('+');
+    TEST_ASSERT_EQUAL_UINT8(0, exercicio_global);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_comeca_no_modulo1);
+    RUN_TEST(test_troca_para_modulo2);
+    RUN_TEST(test_troca_para_modulo3_e_volta);
+    RUN_TEST(test_troca_preserva_serial_e_timer1);
+    RUN_TEST(test_telemetria_depois_da_troca);
+    RUN_TEST(test_anterior_da_volta);
+    return UNITY_END();
+}